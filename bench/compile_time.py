@@ -0,0 +1,120 @@
+"""Measures how LittlePP's compile-time layout computation scales.
+
+For every requested field count, a translation unit declaring a struct with
+that many fields (a mix of types, so there is padding everywhere) is generated
+and compiled with `-fsyntax-only`; the frontend wall time and the compiler's
+peak resident memory are reported. The translation unit instantiates every
+public padding-reflection trait and the serialization plan, i.e. all of the
+library's compile-time traversals.
+
+Run with `bazelisk run //bench:compile_time -- [--compiler clang++-16] ...`.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+# Cycled through to produce padding before most fields.
+FIELD_TYPES = [
+    "char",
+    "int",
+    "short",
+    "double",
+    "unsigned char",
+    "long long",
+    "float",
+    "bool",
+]
+
+DATA_MODEL = """
+using BenchDataModel =
+    little_pp::DataModel<1, 1, 1, 1, 1, 1, 4, 4, 2, 2, 2, 2, 4, 4, 4, 4, 8, 8,
+                         8, 8, 8, 8, 8, 8, 4, 4, 8, 8, 16, 16, 1, 1>;
+"""
+
+TRAITS = """
+namespace pr = little_pp::padding_reflection;
+namespace ser = little_pp::serialization;
+constexpr auto kLocations = pr::serializable_class_padding_locations_v<Wide, BenchDataModel>;
+constexpr auto kByteCounts = pr::serializable_class_padding_locations_byte_counts_v<Wide, BenchDataModel>;
+constexpr auto kIndexes = pr::serializable_class_padding_indexes_v<Wide, BenchDataModel>;
+constexpr auto kSize = ser::serializable_class_size_v<Wide, BenchDataModel>;
+void convert(const unsigned char* src, unsigned char* dst) {
+  ser::convert<Wide, BenchDataModel, BenchDataModel>(src, dst);
+}
+"""
+
+
+def generate_source(field_count):
+    fields = "\n".join(
+        "  {} f{};".format(FIELD_TYPES[i % len(FIELD_TYPES)], i)
+        for i in range(field_count)
+    )
+    return '#include "little_pp.h"\n{}\nstruct Wide {{\n{}\n}};\n{}'.format(
+        DATA_MODEL, fields, TRAITS
+    )
+
+
+def compile_and_measure(compiler, include_dirs, extra_flags, source_path):
+    command = (
+        [compiler, "-std=c++14", "-fsyntax-only"]
+        + ["-I" + include_dir for include_dir in include_dirs]
+        + extra_flags
+        + [source_path]
+    )
+    start = time.monotonic()
+    process = subprocess.Popen(command, stderr=subprocess.PIPE)
+    stderr = process.stderr.read()
+    # os.wait4 reports the rusage of this compiler process alone
+    _, status, rusage = os.wait4(process.pid, 0)
+    elapsed = time.monotonic() - start
+    # ru_maxrss is in KiB on Linux and in bytes on macOS
+    peak_kib = rusage.ru_maxrss // 1024 if sys.platform == "darwin" else rusage.ru_maxrss
+    return os.waitstatus_to_exitcode(status) == 0, elapsed, peak_kib, stderr
+
+
+def main():
+    workspace = os.environ.get(
+        "BUILD_WORKSPACE_DIRECTORY",
+        os.path.dirname(os.path.dirname(os.path.abspath(__file__))),
+    )
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "clang++"))
+    parser.add_argument(
+        "--field-counts", type=int, nargs="+", default=[16, 64, 256, 512]
+    )
+    parser.add_argument(
+        "--pfr-include",
+        default=os.path.join(workspace, "include/impl/3rd_party/pfr/include"),
+    )
+    parser.add_argument(
+        "--extra-flag", action="append", default=[], dest="extra_flags"
+    )
+    args = parser.parse_args()
+
+    include_dirs = [os.path.join(workspace, "include"), args.pfr_include]
+    print("{:>8} {:>12} {:>14}".format("fields", "frontend s", "peak MiB"))
+    with tempfile.TemporaryDirectory() as temp_dir:
+        for field_count in args.field_counts:
+            source_path = os.path.join(temp_dir, "wide_{}.cc".format(field_count))
+            with open(source_path, "w") as source:
+                source.write(generate_source(field_count))
+            ok, elapsed, peak_kib, stderr = compile_and_measure(
+                args.compiler, include_dirs, args.extra_flags, source_path
+            )
+            if not ok:
+                print("{:>8} {:>12} {:>14}".format(field_count, "failed", "-"))
+                sys.stderr.write(stderr.decode(errors="replace")[-2000:])
+                continue
+            print(
+                "{:>8} {:>12.2f} {:>14.1f}".format(
+                    field_count, elapsed, peak_kib / 1024.0
+                )
+            )
+
+
+if __name__ == "__main__":
+    main()
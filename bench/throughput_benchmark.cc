@@ -0,0 +1,293 @@
+// ABOUT: Runtime throughput of serialize, deserialize and convert_n for the
+//        test structs and a generated large struct, under the test data
+//        models in both byte orders. Hand-written memcpy + __builtin_bswap
+//        serializers of the same wire layouts are the baselines; the library
+//        should match them. Runtime plans (runtime_data_model.h) for the same
+//        models should come close to the compile-time path.
+//
+//        Bytes/s counts serialized (wire) bytes. Run with
+//        `bazelisk run -c opt //bench:throughput`; compare runs with Google
+//        Benchmark's tools/compare.py to catch regressions.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "include/data_model.h"
+#include "include/runtime_data_model.h"
+#include "include/serialization.h"
+#include "test/test_data/expected_data_char_short_int_char_struct.h"
+#include "test/test_data/expected_data_char_short_int_struct.h"
+#include "test/test_data/expected_data_int_char.h"
+#include "test/test_data/expected_data_short_uchar_char_uint_struct.h"
+#include "test/test_data/tested_data_models.h"
+
+namespace {
+
+using little_pp::NativeDataModel;
+using test_data::data_models::Simple32BitBigEndianDataModel;
+using test_data::data_models::
+    Simple32BitButIntsNotSelfAlignedBigEndianDataModel;
+using test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel;
+using test_data::data_models::Simple32BitDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+using test_data::struct_int_char::IntCharStruct;
+using test_data::struct_short_uchar_char_uint::ShortUCharCharIntStruct;
+
+// Enough records to leave L1 while the small structs' buffers stay in L2, so
+// that the conversion rather than memory bandwidth is measured.
+constexpr std::size_t kRecordCount = 4096;
+
+// NOLINTBEGIN(google-runtime-int)
+#define LITTLE_PP_BENCH_FIELD_GROUP(n) \
+  char c##n;                           \
+  int i##n;                            \
+  short s##n;                          \
+  double d##n;
+
+// 64 fields with padding between most of them.
+struct LargeStruct {
+  LITTLE_PP_BENCH_FIELD_GROUP(0)
+  LITTLE_PP_BENCH_FIELD_GROUP(1)
+  LITTLE_PP_BENCH_FIELD_GROUP(2)
+  LITTLE_PP_BENCH_FIELD_GROUP(3)
+  LITTLE_PP_BENCH_FIELD_GROUP(4)
+  LITTLE_PP_BENCH_FIELD_GROUP(5)
+  LITTLE_PP_BENCH_FIELD_GROUP(6)
+  LITTLE_PP_BENCH_FIELD_GROUP(7)
+  LITTLE_PP_BENCH_FIELD_GROUP(8)
+  LITTLE_PP_BENCH_FIELD_GROUP(9)
+  LITTLE_PP_BENCH_FIELD_GROUP(10)
+  LITTLE_PP_BENCH_FIELD_GROUP(11)
+  LITTLE_PP_BENCH_FIELD_GROUP(12)
+  LITTLE_PP_BENCH_FIELD_GROUP(13)
+  LITTLE_PP_BENCH_FIELD_GROUP(14)
+  LITTLE_PP_BENCH_FIELD_GROUP(15)
+};
+// NOLINTEND(google-runtime-int)
+#undef LITTLE_PP_BENCH_FIELD_GROUP
+
+template <typename SerializableClassType, typename DataModelType>
+constexpr std::size_t kSerializedSize =
+    little_pp::serialization::serializable_class_size_v<SerializableClassType,
+                                                        DataModelType>;
+
+// Arbitrary, non-zero bytes; the values do not affect the conversion.
+void fill_bytes(unsigned char* bytes, std::size_t size) {
+  for (std::size_t i = 0; i < size; ++i) {
+    bytes[i] = static_cast<unsigned char>(i * 7 + 3);
+  }
+}
+
+template <typename SerializableClassType>
+auto make_objects() -> std::vector<SerializableClassType> {
+  std::vector<SerializableClassType> objects(kRecordCount);
+  fill_bytes(reinterpret_cast<unsigned char*>(objects.data()),
+             objects.size() * sizeof(SerializableClassType));
+  return objects;
+}
+
+void set_throughput(benchmark::State& state, std::size_t wire_size) {
+  const auto records =
+      static_cast<std::int64_t>(state.iterations() * kRecordCount);
+  state.SetItemsProcessed(records);
+  state.SetBytesProcessed(records * static_cast<std::int64_t>(wire_size));
+}
+
+template <typename SerializableClassType, typename WireDataModelType>
+void BM_Serialize(benchmark::State& state) {
+  constexpr std::size_t kWireSize =
+      kSerializedSize<SerializableClassType, WireDataModelType>;
+  const std::vector<SerializableClassType> objects =
+      make_objects<SerializableClassType>();
+  std::vector<unsigned char> wire(kRecordCount * kWireSize);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kRecordCount; ++i) {
+      little_pp::serialization::serialize<
+          SerializableClassType, NativeDataModel, WireDataModelType>(
+          objects[i], wire.data() + i * kWireSize);
+    }
+    benchmark::DoNotOptimize(wire.data());
+    benchmark::ClobberMemory();
+  }
+  set_throughput(state, kWireSize);
+}
+
+template <typename SerializableClassType, typename WireDataModelType>
+void BM_Deserialize(benchmark::State& state) {
+  constexpr std::size_t kWireSize =
+      kSerializedSize<SerializableClassType, WireDataModelType>;
+  std::vector<unsigned char> wire(kRecordCount * kWireSize);
+  fill_bytes(wire.data(), wire.size());
+  std::vector<SerializableClassType> objects(kRecordCount);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kRecordCount; ++i) {
+      little_pp::serialization::deserialize<
+          SerializableClassType, WireDataModelType, NativeDataModel>(
+          wire.data() + i * kWireSize, objects[i]);
+    }
+    benchmark::DoNotOptimize(objects.data());
+    benchmark::ClobberMemory();
+  }
+  set_throughput(state, kWireSize);
+}
+
+// The batch path (SIMD shuffles where the conversion is a byte permutation).
+template <typename SerializableClassType, typename WireDataModelType>
+void BM_ConvertN(benchmark::State& state) {
+  constexpr std::size_t kWireSize =
+      kSerializedSize<SerializableClassType, WireDataModelType>;
+  const std::vector<SerializableClassType> objects =
+      make_objects<SerializableClassType>();
+  std::vector<unsigned char> wire(kRecordCount * kWireSize);
+  for (auto _ : state) {
+    little_pp::serialization::convert_n<SerializableClassType, NativeDataModel,
+                                        WireDataModelType>(
+        reinterpret_cast<const unsigned char*>(objects.data()), wire.data(),
+        kRecordCount);
+    benchmark::DoNotOptimize(wire.data());
+    benchmark::ClobberMemory();
+  }
+  set_throughput(state, kWireSize);
+}
+
+// The same conversions through a cached runtime plan, with the lookup outside
+// the loop as the header recommends.
+template <typename SerializableClassType, typename WireDataModelType>
+void BM_RuntimeSerialize(benchmark::State& state) {
+  const auto& plan =
+      little_pp::serialization::get_runtime_plan<SerializableClassType>(
+          little_pp::serialization::make_data_model_descriptor<
+              WireDataModelType>());
+  const std::size_t wire_size = plan.get_size();
+  const std::vector<SerializableClassType> objects =
+      make_objects<SerializableClassType>();
+  std::vector<unsigned char> wire(kRecordCount * wire_size);
+  for (auto _ : state) {
+    plan.serialize_n(objects.data(), wire.data(), kRecordCount);
+    benchmark::DoNotOptimize(wire.data());
+    benchmark::ClobberMemory();
+  }
+  set_throughput(state, wire_size);
+}
+
+template <typename SerializableClassType, typename WireDataModelType>
+void BM_RuntimeDeserialize(benchmark::State& state) {
+  const auto& plan =
+      little_pp::serialization::get_runtime_plan<SerializableClassType>(
+          little_pp::serialization::make_data_model_descriptor<
+              WireDataModelType>());
+  const std::size_t wire_size = plan.get_size();
+  std::vector<unsigned char> wire(kRecordCount * wire_size);
+  fill_bytes(wire.data(), wire.size());
+  std::vector<SerializableClassType> objects(kRecordCount);
+  for (auto _ : state) {
+    plan.deserialize_n(wire.data(), objects.data(), kRecordCount);
+    benchmark::DoNotOptimize(objects.data());
+    benchmark::ClobberMemory();
+  }
+  set_throughput(state, wire_size);
+}
+
+// Baselines: what a careful hand-written serializer of the same wire layout
+// does.
+
+// Identical layouts: one memcpy of every record, padding included.
+template <typename SerializableClassType>
+void BM_BaselineMemcpy(benchmark::State& state) {
+  const std::vector<SerializableClassType> objects =
+      make_objects<SerializableClassType>();
+  std::vector<unsigned char> wire(kRecordCount *
+                                  sizeof(SerializableClassType));
+  for (auto _ : state) {
+    std::memcpy(wire.data(), objects.data(), wire.size());
+    benchmark::DoNotOptimize(wire.data());
+    benchmark::ClobberMemory();
+  }
+  set_throughput(state, sizeof(SerializableClassType));
+}
+
+template <typename T>
+inline void store_native(unsigned char* dst, T value) {
+  std::memcpy(dst, &value, sizeof(T));
+}
+
+// IntCharStruct in Simple32BitButIntsNotSelfAlignedBigEndianDataModel:
+// bar@0 (big-endian), foo@4, one padding byte.
+inline void baseline_serialize(const IntCharStruct& object,
+                               unsigned char* dst) {
+  store_native(dst,
+               __builtin_bswap32(static_cast<std::uint32_t>(object.bar)));
+  dst[4] = static_cast<unsigned char>(object.foo);
+  dst[5] = 0;
+}
+
+// CharShortIntCharStruct in Simple32BitBigEndianDataModel: bar@0, foo@2,
+// baz@4, buzz@8 (big-endian), padding at 1 and 9-11.
+inline void baseline_serialize(const CharShortIntCharStruct& object,
+                               unsigned char* dst) {
+  dst[0] = static_cast<unsigned char>(object.bar);
+  dst[1] = 0;
+  store_native(dst + 2,
+               __builtin_bswap16(static_cast<std::uint16_t>(object.foo)));
+  store_native(dst + 4,
+               __builtin_bswap32(static_cast<std::uint32_t>(object.baz)));
+  dst[8] = static_cast<unsigned char>(object.buzz);
+  dst[9] = 0;
+  dst[10] = 0;
+  dst[11] = 0;
+}
+
+template <typename SerializableClassType, typename WireDataModelType>
+void BM_BaselineSwap(benchmark::State& state) {
+  constexpr std::size_t kWireSize =
+      kSerializedSize<SerializableClassType, WireDataModelType>;
+  const std::vector<SerializableClassType> objects =
+      make_objects<SerializableClassType>();
+  std::vector<unsigned char> wire(kRecordCount * kWireSize);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kRecordCount; ++i) {
+      baseline_serialize(objects[i], wire.data() + i * kWireSize);
+    }
+    benchmark::DoNotOptimize(wire.data());
+    benchmark::ClobberMemory();
+  }
+  set_throughput(state, kWireSize);
+}
+
+// Every operation under every test data model.
+#define LITTLE_PP_BENCH_ALL_MODELS(bm, type)                                 \
+  BENCHMARK_TEMPLATE(bm, type, Simple32BitDataModel);                        \
+  BENCHMARK_TEMPLATE(bm, type, Simple32BitButIntsNotSelfAlignedDataModel);   \
+  BENCHMARK_TEMPLATE(bm, type, Simple32BitBigEndianDataModel);               \
+  BENCHMARK_TEMPLATE(bm, type,                                               \
+                     Simple32BitButIntsNotSelfAlignedBigEndianDataModel)
+
+#define LITTLE_PP_BENCH_ALL_OPERATIONS(type)              \
+  LITTLE_PP_BENCH_ALL_MODELS(BM_Serialize, type);         \
+  LITTLE_PP_BENCH_ALL_MODELS(BM_Deserialize, type);       \
+  LITTLE_PP_BENCH_ALL_MODELS(BM_ConvertN, type);          \
+  LITTLE_PP_BENCH_ALL_MODELS(BM_RuntimeSerialize, type);  \
+  LITTLE_PP_BENCH_ALL_MODELS(BM_RuntimeDeserialize, type)
+
+LITTLE_PP_BENCH_ALL_OPERATIONS(IntCharStruct);
+LITTLE_PP_BENCH_ALL_OPERATIONS(CharShortIntCharStruct);
+LITTLE_PP_BENCH_ALL_OPERATIONS(CharIntLongStruct);
+LITTLE_PP_BENCH_ALL_OPERATIONS(ShortUCharCharIntStruct);
+LITTLE_PP_BENCH_ALL_OPERATIONS(LargeStruct);
+
+BENCHMARK_TEMPLATE(BM_BaselineMemcpy, IntCharStruct);
+BENCHMARK_TEMPLATE(BM_BaselineMemcpy, CharShortIntCharStruct);
+BENCHMARK_TEMPLATE(BM_BaselineMemcpy, LargeStruct);
+BENCHMARK_TEMPLATE(BM_BaselineSwap, IntCharStruct,
+                   Simple32BitButIntsNotSelfAlignedBigEndianDataModel);
+BENCHMARK_TEMPLATE(BM_BaselineSwap, CharShortIntCharStruct,
+                   Simple32BitBigEndianDataModel);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,31 @@
+// ABOUT: The public API for LittlePP's sub-byte (bit) fields
+#ifndef LITTLE_PP_BIT_FIELDS_H
+#define LITTLE_PP_BIT_FIELDS_H
+
+#include <cstddef>
+
+#include "impl/bit_fields.h"
+
+namespace little_pp {
+
+// Fields of the given bit widths packed into one StorageType word, the first
+// field in the least significant bits. Use it as a member of a serializable
+// class in place of C++ bit-fields (which cannot be reflected):
+//
+//   struct ControlRegister {
+//     // mode: 3 bits, enable: 1 bit, reserved: 4 bits, divider: 8 bits
+//     little_pp::BitFields<std::uint16_t, 3, 1, 4, 8> control;
+//     std::uint16_t threshold;
+//   };
+//
+//   reg.control = decltype(reg.control)::pack(kModeBurst, 1, 0, divider);
+//   reg.control.set<kEnableField>(0);
+//
+// The data model's size and byte order for StorageType apply to the whole
+// word, which is converted in a single operation.
+template <typename StorageType, std::size_t... kWidths>
+using BitFields = litte_pp::impl::BitFields<StorageType, kWidths...>;
+
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_BIT_FIELDS_H
@@ -0,0 +1,85 @@
+// ABOUT: The public API for LittlePP's checksummed serialization
+#ifndef LITTLE_PP_CHECKSUM_H
+#define LITTLE_PP_CHECKSUM_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "impl/checksum.h"
+#include "impl/checksummed_conversion.h"
+#include "impl/layout.h"
+#include "impl/native_layout.h"
+#include "serialization.h"
+
+namespace little_pp {
+namespace serialization {
+
+// Checksum policies for serialize_with_checksum and
+// deserialize_with_checksum. Any type with the interface described in
+// impl/checksum.h works too.
+using Crc32c = litte_pp::impl::Crc32c;
+using Crc16Ccitt = litte_pp::impl::Crc16Ccitt;
+using Fletcher16 = litte_pp::impl::Fletcher16;
+
+// Violate the google style guide in favor of std library convention.
+// NOLINTBEGIN(readability-identifier-naming)
+// The size of a serialized object followed by its checksum.
+template <typename ChecksumType, typename SerializableClassType,
+          typename DataModelType>
+constexpr std::size_t checksummed_size_v =
+    serializable_class_size_v<SerializableClassType, DataModelType> +
+    ChecksumType::kSize;
+// NOLINTEND(readability-identifier-naming)
+
+// Serializes `object` into `dst` like serialize() and appends the checksum of
+// the serialized bytes (padding included), in DstDataModelType's byte order.
+// `dst` must span checksummed_size_v. The checksum is computed while the
+// object is written, not in a second pass over `dst`. The padding is part of
+// the checksum, so PaddingPolicy::kSkip is not accepted:
+//
+//   unsigned char frame[checksummed_size_v<Crc32c, Frame, WireModel>];
+//   serialize_with_checksum<Crc32c, Frame, NativeDataModel, WireModel>(
+//       object, frame);
+template <typename ChecksumType, typename SerializableClassType,
+          typename SrcDataModelType, typename DstDataModelType,
+          PaddingPolicy kPaddingPolicy = PaddingPolicy::kZero>
+inline void serialize_with_checksum(const SerializableClassType& object,
+                                    unsigned char* dst) {
+  static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                "Serialized class type must be trivially copyable.");
+  static_assert(
+      is_native_layout_v<SerializableClassType, SrcDataModelType>,
+      "SrcDataModelType does not describe this architecture's layout of "
+      "the class.");
+  litte_pp::impl::ChecksummedConversion<
+      ChecksumType, SerializableClassType, SrcDataModelType, DstDataModelType,
+      kPaddingPolicy>::convert_and_sign(reinterpret_cast<const unsigned char*>(
+                                            &object),
+                                        dst);
+}
+
+// Deserializes `src` into `object` like deserialize() and returns whether the
+// checksum that follows the serialized bytes matches them. `object` is
+// written even when it does not.
+template <typename ChecksumType, typename SerializableClassType,
+          typename SrcDataModelType, typename DstDataModelType,
+          PaddingPolicy kPaddingPolicy = PaddingPolicy::kZero>
+inline auto deserialize_with_checksum(const unsigned char* src,
+                                      SerializableClassType& object) -> bool {
+  static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                "Deserialized class type must be trivially copyable.");
+  static_assert(
+      is_native_layout_v<SerializableClassType, DstDataModelType>,
+      "DstDataModelType does not describe this architecture's layout of "
+      "the class.");
+  return litte_pp::impl::ChecksummedConversion<
+      ChecksumType, SerializableClassType, SrcDataModelType, DstDataModelType,
+      kPaddingPolicy>::convert_and_verify(src,
+                                          reinterpret_cast<unsigned char*>(
+                                              &object));
+}
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_CHECKSUM_H
@@ -0,0 +1,66 @@
+// ABOUT: The public API for LittlePP's column (struct-of-arrays)
+//        deserialization
+#ifndef LITTLE_PP_COLUMNS_H
+#define LITTLE_PP_COLUMNS_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "impl/column_conversion.h"
+#include "serialization.h"
+
+namespace little_pp {
+namespace serialization {
+
+// One std::vector per field of SerializableClassType, in declaration order
+// (bool fields get a contiguous BoolColumn, as std::vector<bool> has no data):
+//
+//   SoA<Sample> columns;
+//   deserialize_columns<Sample, WireModel, NativeDataModel>(src, n, columns);
+//   const std::vector<float>& temperatures = columns.get<2>();
+template <typename SerializableClassType>
+using SoA = litte_pp::impl::SoA<SerializableClassType>;
+
+using BoolColumn = litte_pp::impl::BoolColumn;
+
+// A std::tuple of one pointer per field, for caller-owned columns.
+template <typename SerializableClassType>
+using ColumnPointers =
+    typename litte_pp::impl::ColumnTypes<SerializableClassType>::Pointers;
+
+// Deserializes `count` consecutive records laid out in SrcDataModelType into
+// `columns`, which must each hold `count` values. Records are strided by
+// serializable_class_size_v<SerializableClassType, SrcDataModelType>.
+// DstDataModelType must describe how this architecture lays out the class
+// (e.g. NativeDataModel); see is_native_layout_v.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+inline void deserialize_columns(
+    const unsigned char* src, std::size_t count,
+    const ColumnPointers<SerializableClassType>& columns) {
+  static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                "Deserialized class type must be trivially copyable.");
+  static_assert(
+      is_native_layout_v<SerializableClassType, DstDataModelType>,
+      "DstDataModelType does not describe this architecture's layout of "
+      "the class.");
+  litte_pp::impl::ColumnConversion<SerializableClassType, SrcDataModelType,
+                                   DstDataModelType>::convert(src, count,
+                                                              columns);
+}
+
+// Same, but resizes `columns` to `count` first.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+inline void deserialize_columns(const unsigned char* src, std::size_t count,
+                                SoA<SerializableClassType>& columns) {
+  columns.resize(count);
+  deserialize_columns<SerializableClassType, SrcDataModelType,
+                      DstDataModelType>(src, count,
+                                        columns.get_column_pointers());
+}
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_COLUMNS_H
@@ -26,7 +26,99 @@ constexpr auto get_this_architecture_endianess() -> Endianess {
 }
 #endif  //__BYTE_ORDER__
 
-// Encode sizeof and alignof of supported POD type into a DataModel type.
+}  // namespace little_pp
+
+namespace litte_pp {
+namespace impl {
+
+// Position of each supported type within DataModel's template parameters.
+template <class T>
+struct DataModelTypeIndex {
+  static_assert(sizeof(T) == 0, "Type not supported by DataModel.");
+};
+
+// NOLINTBEGIN(google-runtime-int)
+template <>
+struct DataModelTypeIndex<char> {
+  static constexpr std::size_t kValue = 0;
+};
+template <>
+struct DataModelTypeIndex<unsigned char> {
+  static constexpr std::size_t kValue = 1;
+};
+template <>
+struct DataModelTypeIndex<signed char> {
+  static constexpr std::size_t kValue = 2;
+};
+template <>
+struct DataModelTypeIndex<wchar_t> {
+  static constexpr std::size_t kValue = 3;
+};
+template <>
+struct DataModelTypeIndex<short> {
+  static constexpr std::size_t kValue = 4;
+};
+template <>
+struct DataModelTypeIndex<unsigned short> {
+  static constexpr std::size_t kValue = 5;
+};
+template <>
+struct DataModelTypeIndex<int> {
+  static constexpr std::size_t kValue = 6;
+};
+template <>
+struct DataModelTypeIndex<unsigned int> {
+  static constexpr std::size_t kValue = 7;
+};
+template <>
+struct DataModelTypeIndex<long> {
+  static constexpr std::size_t kValue = 8;
+};
+template <>
+struct DataModelTypeIndex<unsigned long> {
+  static constexpr std::size_t kValue = 9;
+};
+template <>
+struct DataModelTypeIndex<long long> {
+  static constexpr std::size_t kValue = 10;
+};
+template <>
+struct DataModelTypeIndex<unsigned long long> {
+  static constexpr std::size_t kValue = 11;
+};
+template <>
+struct DataModelTypeIndex<float> {
+  static constexpr std::size_t kValue = 12;
+};
+template <>
+struct DataModelTypeIndex<double> {
+  static constexpr std::size_t kValue = 13;
+};
+template <>
+struct DataModelTypeIndex<long double> {
+  static constexpr std::size_t kValue = 14;
+};
+template <>
+struct DataModelTypeIndex<bool> {
+  static constexpr std::size_t kValue = 15;
+};
+// NOLINTEND(google-runtime-int)
+
+// cv-qualified fields are laid out like their unqualified type
+template <class T>
+struct DataModelTypeIndex<const T> : DataModelTypeIndex<T> {};
+template <class T>
+struct DataModelTypeIndex<volatile T> : DataModelTypeIndex<T> {};
+template <class T>
+struct DataModelTypeIndex<const volatile T> : DataModelTypeIndex<T> {};
+
+}  // namespace impl
+}  // namespace litte_pp
+
+namespace little_pp {
+
+// Encode sizeof and alignof of supported POD type, and the byte order, into a
+// DataModel type.
 // See https://en.cppreference.com/w/cpp/language/types
 template <std::size_t kCharSize, std::size_t kCharAlign,
           std::size_t kUnsignedCharSize, std::size_t kUnsignedCharAlign,
@@ -49,183 +141,131 @@ template <std::size_t kCharSize, std::size_t kCharAlign,
           std::size_t kDoubleSize, std::size_t kDoubleAlign,
           std::size_t kLongDoubleSize, std::size_t kLongDoubleAlign,
 
-          std::size_t kBoolSize, std::size_t kBoolAlign>
+          std::size_t kBoolSize, std::size_t kBoolAlign,
+
+          // Byte order of every multi-byte type; defaults to the compiling
+          // architecture's so that padding-only data models stay terse.
+          Endianess kEndianess = get_this_architecture_endianess()>
 struct DataModel {
+  static constexpr auto get_endianess() -> Endianess { return kEndianess; }
+
+  // NOTE: get_size and get_alignment cannot be implemented using template full
+  //       specialization:
+  //       ```
+  //       An explicit specialization of a member function, member class or
+  //       static data member of a class template shall be declared in the
+  //       namespace of which the class template is a member.
+  //       ```C++03, §14.7.3/2:
+  //
+  //       Still an issue in C+14. See this stack overflow page
+  //       page:https://stackoverflow.com/questions/3052579/explicit-specialization-in-non-namespace-scope
+  //       note that a user comments this is no longer true for C++17.
+  //
+  //       Instead, the type is mapped to a position (at namespace scope, where
+  //       specialization is allowed) and the value is a constant-time table
+  //       lookup, ordered like the template parameters.
+
+  template <class T>
+  static constexpr auto get_size() -> std::size_t {
+    constexpr std::size_t kSizes[] = {
+        kCharSize,
+        kUnsignedCharSize,
+        kSignedCharSize,
+        kWCharSize,
+        kShortSize,
+        kUnsignedShortSize,
+        kIntSize,
+        kUnsignedIntSize,
+        kLongSize,
+        kUnsignedLongSize,
+        kLongLongSize,
+        kUnsignedLongLongSize,
+        kFloatSize,
+        kDoubleSize,
+        kLongDoubleSize,
+        kBoolSize,
+    };
+    return kSizes[litte_pp::impl::DataModelTypeIndex<T>::kValue];
+  }
+
+  template <class T>
+  static constexpr auto get_alignment() -> std::size_t {
+    constexpr std::size_t kAlignments[] = {
+        kCharAlign,
+        kUnsignedCharAlign,
+        kSignedCharAlign,
+        kWCharAlign,
+        kShortAlign,
+        kUnsignedShortAlign,
+        kIntAlign,
+        kUnsignedIntAlign,
+        kLongAlign,
+        kUnsignedLongAlign,
+        kLongLongAlign,
+        kUnsignedLongLongAlign,
+        kFloatAlign,
+        kDoubleAlign,
+        kLongDoubleAlign,
+        kBoolAlign,
+    };
+    return kAlignments[litte_pp::impl::DataModelTypeIndex<T>::kValue];
+  }
+};
+
+// A wire layout without padding: every field follows the previous one back to
+// back, with the size and byte order DataModelType gives it. Use it in place of
+// a DataModel on links that cannot afford to carry padding; serializing into it
+// compacts a class and deserializing from it expands the class again.
+template <class DataModelType>
+struct Packed {
+  static constexpr auto get_endianess() -> Endianess {
+    return DataModelType::get_endianess();
+  }
+
   template <class T>
   static constexpr auto get_size() -> std::size_t {
-    // NOTE: this method cannot be implemented using template full
-    //       specialization:
-    //       ```
-    //       An explicit specialization of a member function, member class or
-    //       static data member of a class template shall be declared in the
-    //       namespace of which the class template is a member.
-    //       ```C++03, §14.7.3/2:
-    //
-    //       Still an issue in C+14. See this stack overflow page
-    //       page:https://stackoverflow.com/questions/3052579/explicit-specialization-in-non-namespace-scope
-    //       note that a user comments this is no longer true for C++17.
-    if (std::is_same<T, char>::value) {
-      return static_cast<std::size_t>(kCharSize);
-    }
-    if (std::is_same<T, char>::value) {
-      return static_cast<std::size_t>(kCharSize);
-    }
-
-    if (std::is_same<T, unsigned char>::value) {
-      return static_cast<std::size_t>(kUnsignedCharSize);
-    }
-
-    if (std::is_same<T, signed char>::value) {
-      return static_cast<std::size_t>(kSignedCharSize);
-    }
-
-    if (std::is_same<T, wchar_t>::value) {
-      return static_cast<std::size_t>(kWCharSize);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, short>::value) {
-      return static_cast<std::size_t>(kShortSize);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, unsigned short>::value) {
-      return static_cast<std::size_t>(kUnsignedShortSize);
-    }
-
-    if (std::is_same<T, int>::value) {
-      return static_cast<std::size_t>(kIntSize);
-    }
-
-    if (std::is_same<T, unsigned int>::value) {
-      return static_cast<std::size_t>(kUnsignedIntSize);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, long>::value) {
-      return static_cast<std::size_t>(kLongSize);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, unsigned long>::value) {
-      return static_cast<std::size_t>(kUnsignedLongSize);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, long long>::value) {
-      return static_cast<std::size_t>(kLongLongSize);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, unsigned long long>::value) {
-      return static_cast<std::size_t>(kUnsignedLongLongSize);
-    }
-
-    if (std::is_same<T, float>::value) {
-      return static_cast<std::size_t>(kFloatSize);
-    }
-
-    if (std::is_same<T, double>::value) {
-      return static_cast<std::size_t>(kDoubleSize);
-    }
-
-    if (std::is_same<T, long double>::value) {
-      return static_cast<std::size_t>(kLongDoubleSize);
-    }
-
-    if (std::is_same<T, bool>::value) {
-      return static_cast<std::size_t>(kBoolSize);
-    }
+    return DataModelType::template get_size<T>();
   }
 
   template <class T>
   static constexpr auto get_alignment() -> std::size_t {
-    // NOTE: this method cannot be implemented using template full
-    //       specialization:
-    //       ```
-    //       An explicit specialization of a member function, member class or
-    //       static data member of a class template shall be declared in the
-    //       namespace of which the class template is a member.
-    //       ```C++03, §14.7.3/2:
-    //
-    //       Still an issue in C+14. See this stack overflow page
-    //       page:https://stackoverflow.com/questions/3052579/explicit-specialization-in-non-namespace-scope
-    //       note that a user comments this is no longer true for C++17.
-    if (std::is_same<T, char>::value) {
-      return static_cast<std::size_t>(kCharAlign);
-    }
-    if (std::is_same<T, char>::value) {
-      return static_cast<std::size_t>(kCharAlign);
-    }
-
-    if (std::is_same<T, unsigned char>::value) {
-      return static_cast<std::size_t>(kUnsignedCharAlign);
-    }
-
-    if (std::is_same<T, signed char>::value) {
-      return static_cast<std::size_t>(kSignedCharAlign);
-    }
-
-    if (std::is_same<T, wchar_t>::value) {
-      return static_cast<std::size_t>(kWCharAlign);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, short>::value) {
-      return static_cast<std::size_t>(kShortAlign);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, unsigned short>::value) {
-      return static_cast<std::size_t>(kUnsignedShortAlign);
-    }
-
-    if (std::is_same<T, int>::value) {
-      return static_cast<std::size_t>(kIntAlign);
-    }
-
-    if (std::is_same<T, unsigned int>::value) {
-      return static_cast<std::size_t>(kUnsignedIntAlign);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, long>::value) {
-      return static_cast<std::size_t>(kLongAlign);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, unsigned long>::value) {
-      return static_cast<std::size_t>(kUnsignedLongAlign);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, long long>::value) {
-      return static_cast<std::size_t>(kLongLongAlign);
-    }
-
-    // NOLINTNEXTLINE(google-runtime-int)
-    if (std::is_same<T, unsigned long long>::value) {
-      return static_cast<std::size_t>(kUnsignedLongLongAlign);
-    }
-
-    if (std::is_same<T, float>::value) {
-      return static_cast<std::size_t>(kFloatAlign);
-    }
-
-    if (std::is_same<T, double>::value) {
-      return static_cast<std::size_t>(kDoubleAlign);
-    }
-
-    if (std::is_same<T, long double>::value) {
-      return static_cast<std::size_t>(kLongDoubleAlign);
-    }
-
-    if (std::is_same<T, bool>::value) {
-      return static_cast<std::size_t>(kBoolAlign);
-    }
+    return 1;
   }
 };
 
+#ifdef __BYTE_ORDER__
+// The data model of the compiling architecture, from sizeof and alignof of
+// every supported type.
+//
+// NOTE: alignof reports a type's alignment as a complete object, which some
+//       ABIs do not use inside classes (e.g. double and long long on i386
+//       System V are 8-byte aligned alone but 4-byte aligned as members).
+//       Check classes with is_native_layout_v before relying on this model.
+// NOLINTBEGIN(google-runtime-int)
+using NativeDataModel = DataModel<
+    sizeof(char), alignof(char), sizeof(unsigned char), alignof(unsigned char),
+    sizeof(signed char), alignof(signed char), sizeof(wchar_t),
+    alignof(wchar_t),
+
+    sizeof(short), alignof(short), sizeof(unsigned short),
+    alignof(unsigned short),
+
+    sizeof(int), alignof(int), sizeof(unsigned int), alignof(unsigned int),
+
+    sizeof(long), alignof(long), sizeof(unsigned long), alignof(unsigned long),
+
+    sizeof(long long), alignof(long long), sizeof(unsigned long long),
+    alignof(unsigned long long),
+
+    sizeof(float), alignof(float), sizeof(double), alignof(double),
+    sizeof(long double), alignof(long double),
+
+    sizeof(bool), alignof(bool),
+
+    get_this_architecture_endianess()>;
+// NOLINTEND(google-runtime-int)
+#endif  //__BYTE_ORDER__
+
 }  // namespace little_pp
 
 #endif  // DATA_MODEL_H
@@ -0,0 +1,36 @@
+// ABOUT: The public API for LittlePP's field-level delta encoding
+#ifndef LITTLE_PP_DELTA_H
+#define LITTLE_PP_DELTA_H
+
+#include "impl/delta.h"
+
+namespace little_pp {
+namespace serialization {
+
+// Encodes a stream of objects as keyframes and deltas that carry only the
+// fields that changed since the previous frame, in WireDataModelType's layout:
+//
+//   DeltaEncoder<Telemetry, NativeDataModel, WireModel> encoder(100);
+//   unsigned char frame[decltype(encoder)::kMaxFrameSize];
+//   send(frame, encoder.encode(telemetry, frame));
+//
+// Every 100th frame is a keyframe, so a receiver that lost frames resyncs;
+// request_keyframe() forces one.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename WireDataModelType>
+using DeltaEncoder =
+    litte_pp::impl::DeltaEncoder<SerializableClassType, SrcDataModelType,
+                                 WireDataModelType>;
+
+// Decodes the frames of a DeltaEncoder; decode() rejects deltas (returns 0)
+// until a keyframe has been decoded.
+template <typename SerializableClassType, typename WireDataModelType,
+          typename DstDataModelType>
+using DeltaDecoder =
+    litte_pp::impl::DeltaDecoder<SerializableClassType, WireDataModelType,
+                                 DstDataModelType>;
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_DELTA_H
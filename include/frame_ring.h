@@ -0,0 +1,42 @@
+// ABOUT: The public API for LittlePP's single-producer/single-consumer frame
+//        ring
+#ifndef LITTLE_PP_FRAME_RING_H
+#define LITTLE_PP_FRAME_RING_H
+
+#include <cstddef>
+
+#include "data_model.h"
+#include "impl/frame_ring.h"
+
+namespace little_pp {
+namespace serialization {
+
+// A lock-free ring of kCapacity (a power of two) frames laid out in
+// FrameDataModelType, for one producer and one consumer thread (or interrupt
+// handler). Pushing only copies the frame's bytes; the consumer converts:
+//
+//   FrameRing<SensorFrame, CoprocessorDataModel, 64> ring;
+//   // in the ISR
+//   ring.try_push(fifo_bytes);
+//   // in the worker
+//   SensorFrame frame;
+//   while (ring.try_pop(frame)) { ... }
+//   // or read a few fields in place
+//   ring.try_consume([](const decltype(ring)::View& view) {
+//     use(view.get<kStatusField>());
+//   });
+//
+// The ring is over-aligned (its positions sit on separate cache lines), so
+// define it statically or on the stack; C++14's operator new does not honor
+// the alignment.
+template <typename SerializableClassType, typename FrameDataModelType,
+          std::size_t kCapacity,
+          typename NativeDataModelType = little_pp::NativeDataModel>
+using FrameRing =
+    litte_pp::impl::FrameRing<SerializableClassType, FrameDataModelType,
+                              kCapacity, NativeDataModelType>;
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_FRAME_RING_H
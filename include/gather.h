@@ -0,0 +1,37 @@
+// ABOUT: The public API for LittlePP's gather (iovec) serialization. This
+//        header needs POSIX's <sys/uio.h>, so it is not part of little_pp.h;
+//        use the //include:little_pp_posix target.
+#ifndef LITTLE_PP_GATHER_H
+#define LITTLE_PP_GATHER_H
+
+#include <cstddef>
+
+#include "impl/gather.h"
+#include "serialization.h"
+
+namespace little_pp {
+namespace serialization {
+
+// Serializes an object as an iovec list, without copying the fields that are
+// already in DstDataModelType's layout:
+//
+//   GatherSerializer<Frame, NativeDataModel, WireModel> gather(frame);
+//   writev(fd, gather.get_iovecs(), gather.get_iovec_count());
+//
+// The concatenated iovecs equal serialize<...>()'s output. They reference both
+// `frame` and the serializer, so neither may change or go away while the list
+// is in use; reset() re-targets the serializer at another object.
+// Copy runs shorter than kMinReferencedSize bytes are copied rather than
+// referenced.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType,
+          std::size_t kMinReferencedSize =
+              litte_pp::impl::kDefaultMinReferencedSize>
+using GatherSerializer =
+    litte_pp::impl::GatherSerializer<SerializableClassType, SrcDataModelType,
+                                     DstDataModelType, kMinReferencedSize>;
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_GATHER_H
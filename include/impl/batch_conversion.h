@@ -0,0 +1,375 @@
+// ABOUT: Conversion of arrays of records. When a CopyPlan is a pure byte
+//        permutation (no field changes width), each destination byte is
+//        either a source byte or zero, which is exactly what x86's pshufb
+//        computes. The permutations are derived from the plan's runs at
+//        compile time.
+//
+//        Records need not fit a 16-byte vector, nor divide it. The destination
+//        is cut into periods of lcm(dst size, 16) bytes, i.e. a whole number
+//        of records and of vectors, and each of the period's vectors gets its
+//        own shuffle:
+//
+//          - 6-byte records: 48-byte periods of 8 records, 3 vectors
+//          - 12-byte records: 48-byte periods of 4 records, 3 vectors
+//          - 24-byte records: 48-byte periods of 2 records, 3 vectors
+//
+//        A destination vector's bytes come from a window of source bytes; the
+//        window is loaded as one vector, or as two adjacent ones (each with
+//        its own shuffle, OR'ed together) when it is wider than 16 bytes.
+//        Plans whose windows are wider than 32 bytes (fields moved far apart),
+//        and periods of more than kMaxShufflePeriodVectors vectors, are not
+//        vectorized.
+//
+//        The vector paths are compiled with target attributes and selected at
+//        runtime from the CPU's features, which are queried once; every other
+//        case (including the last records, which may not fill a whole period)
+//        uses the scalar CopyPlan. Vectors store padding too, so only
+//        PaddingPolicy::kZero uses the vector paths.
+
+#ifndef LITTLE_PP_IMPL_BATCH_CONVERSION_H
+#define LITTLE_PP_IMPL_BATCH_CONVERSION_H
+
+#include <cstddef>
+#include <cstring>
+
+#include "field_layout.h"
+#include "serialization.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define LITTLE_PP_IMPL_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace litte_pp {
+
+namespace impl {
+
+constexpr std::size_t kShuffleLaneSize = 16;
+// pshufb writes zero for mask bytes with the high bit set
+constexpr unsigned char kShuffleZero = 0x80;
+// Bounds the shuffle tables (two 16-byte masks per vector) of a class.
+constexpr std::size_t kMaxShufflePeriodVectors = 16;
+
+constexpr auto greatest_common_divisor(std::size_t a, std::size_t b)
+    -> std::size_t {
+  while (b != 0) {
+    const std::size_t remainder = a % b;
+    a = b;
+    b = remainder;
+  }
+  return a;
+}
+
+// The shuffles producing one destination vector of a period. The vector's
+// source window starts src_offset bytes into the period's source records.
+struct ShuffleVector {
+  // applied to the 16 source bytes at src_offset
+  unsigned char low[kShuffleLaneSize];
+  // applied to the 16 source bytes after those, if needs_high
+  unsigned char high[kShuffleLaneSize];
+  std::size_t src_offset;
+  bool needs_high;
+};
+
+#ifdef LITTLE_PP_IMPL_X86_SIMD
+// Queried once; __builtin_cpu_supports is not free.
+inline auto has_avx2() -> bool {
+  static const bool has = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return has;
+}
+
+inline auto has_ssse3() -> bool {
+  static const bool has = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") != 0;
+  }();
+  return has;
+}
+#endif  // LITTLE_PP_IMPL_X86_SIMD
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType,
+          PaddingPolicy kPaddingPolicy = PaddingPolicy::kZero>
+struct BatchConversion {
+  using Plan = CopyPlan<SerializableClassType, SrcDataModelType,
+                        DstDataModelType, kPaddingPolicy>;
+  static constexpr std::size_t kSrcSize = Plan::SrcLayout::kSize;
+  static constexpr std::size_t kDstSize = Plan::DstLayout::kSize;
+
+  static constexpr auto is_byte_permutation() -> bool {
+    for (std::size_t i = 0; i < Plan::kRunCount; ++i) {
+      if (Plan::kRuns[i].kind == RunKind::kConvert &&
+          Plan::kRuns[i].src_size != Plan::kRuns[i].dst_size) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Destination bytes per period; 0 when there is nothing to convert.
+  static constexpr std::size_t kPeriodSize =
+      (kSrcSize == 0 || kDstSize == 0)
+          ? 0
+          : kDstSize / greatest_common_divisor(kDstSize, kShuffleLaneSize) *
+                kShuffleLaneSize;
+  static constexpr std::size_t kPeriodRecords =
+      (kDstSize == 0) ? 0 : kPeriodSize / kDstSize;
+  static constexpr std::size_t kPeriodVectors = kPeriodSize / kShuffleLaneSize;
+  // Tables are only built for periods short enough to vectorize.
+  static constexpr std::size_t kTableVectors =
+      (kPeriodVectors <= kMaxShufflePeriodVectors) ? kPeriodVectors : 0;
+
+  // A destination record byte without a source byte (padding).
+  static constexpr std::size_t kNoSource = ~std::size_t{0};
+
+  // For each byte of one destination record, the source byte it comes from.
+  static constexpr auto make_record_shuffle()
+      -> ConstexprArray<std::size_t, kDstSize> {
+    ConstexprArray<std::size_t, kDstSize> shuffle{};
+    for (std::size_t i = 0; i < Plan::kRunCount; ++i) {
+      const CopyRun run = Plan::kRuns[i];
+      const bool is_reversed = run.kind == RunKind::kConvert;
+      for (std::size_t b = 0; b < run.dst_size; ++b) {
+        shuffle[run.dst_offset + b] =
+            (run.kind == RunKind::kZero) ? kNoSource
+            : is_reversed ? run.src_offset + run.dst_size - 1 - b
+                          : run.src_offset + b;
+      }
+    }
+    return shuffle;
+  }
+
+  // The source byte (from the period's first source byte) of destination
+  // byte `index` of a period.
+  static constexpr auto get_period_source(
+      const ConstexprArray<std::size_t, kDstSize>& record, std::size_t index)
+      -> std::size_t {
+    return (record[index % kDstSize] == kNoSource)
+               ? kNoSource
+               : (index / kDstSize) * kSrcSize + record[index % kDstSize];
+  }
+
+  struct Shuffles {
+    ConstexprArray<ShuffleVector, kTableVectors> vectors;
+    // every vector's source window fits two vectors
+    bool is_complete;
+  };
+
+  static constexpr auto make_shuffles() -> Shuffles {
+    Shuffles shuffles{{}, true};
+    const ConstexprArray<std::size_t, kDstSize> record = make_record_shuffle();
+    for (std::size_t v = 0; v < kTableVectors; ++v) {
+      ShuffleVector& vector = shuffles.vectors[v];
+      std::size_t first = kNoSource;
+      for (std::size_t j = 0; j < kShuffleLaneSize; ++j) {
+        const std::size_t source =
+            get_period_source(record, v * kShuffleLaneSize + j);
+        if (source < first) {
+          first = source;
+        }
+      }
+      vector.src_offset = (first == kNoSource) ? 0 : first;
+      vector.needs_high = false;
+      for (std::size_t j = 0; j < kShuffleLaneSize; ++j) {
+        const std::size_t source =
+            get_period_source(record, v * kShuffleLaneSize + j);
+        vector.low[j] = kShuffleZero;
+        vector.high[j] = kShuffleZero;
+        if (source == kNoSource) {
+          continue;
+        }
+        const std::size_t window_index = source - vector.src_offset;
+        if (window_index < kShuffleLaneSize) {
+          vector.low[j] = static_cast<unsigned char>(window_index);
+        } else if (window_index < 2 * kShuffleLaneSize) {
+          vector.high[j] =
+              static_cast<unsigned char>(window_index - kShuffleLaneSize);
+          vector.needs_high = true;
+        } else {
+          shuffles.is_complete = false;
+        }
+      }
+    }
+    return shuffles;
+  }
+
+  static constexpr Shuffles kShuffles = make_shuffles();
+
+  // How far past a period's first source byte its loads reach.
+  static constexpr auto get_src_reach() -> std::size_t {
+    std::size_t reach = 0;
+    for (std::size_t v = 0; v < kTableVectors; ++v) {
+      const ShuffleVector& vector = kShuffles.vectors[v];
+      const std::size_t end =
+          vector.src_offset +
+          (vector.needs_high ? 2 * kShuffleLaneSize : kShuffleLaneSize);
+      if (end > reach) {
+        reach = end;
+      }
+    }
+    return reach;
+  }
+
+  static constexpr std::size_t kSrcReach = get_src_reach();
+  static constexpr bool kIsShuffleable =
+      kPaddingPolicy == PaddingPolicy::kZero && is_byte_permutation() &&
+      kPeriodSize > 0 && kPeriodVectors <= kMaxShufflePeriodVectors &&
+      kShuffles.is_complete;
+
+  static void convert_scalar(const unsigned char* src, unsigned char* dst,
+                             std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      Plan::apply(src + i * kSrcSize, dst + i * kDstSize);
+    }
+  }
+
+#ifdef LITTLE_PP_IMPL_X86_SIMD
+  // The vector paths return the number of records they converted.
+  //
+  // A period stores exactly its kPeriodRecords records, but its loads may
+  // reach past them (kSrcReach), so it may only run while both fit.
+  static auto period_available(std::size_t first_record, std::size_t count)
+      -> bool {
+    if (first_record > count) {
+      return false;
+    }
+    const std::size_t remaining = count - first_record;
+    return remaining >= kPeriodRecords && remaining * kSrcSize >= kSrcReach;
+  }
+
+  __attribute__((target("ssse3"))) static auto shuffle_vector_ssse3(
+      const ShuffleVector& vector, const unsigned char* src) -> __m128i {
+    const unsigned char* window = src + vector.src_offset;
+    __m128i converted = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(window)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(vector.low)));
+    if (vector.needs_high) {
+      converted = _mm_or_si128(
+          converted,
+          _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                               window + kShuffleLaneSize)),
+                           _mm_loadu_si128(
+                               reinterpret_cast<const __m128i*>(vector.high))));
+    }
+    return converted;
+  }
+
+  __attribute__((target("ssse3"))) static auto convert_ssse3(
+      const unsigned char* src, unsigned char* dst, std::size_t count)
+      -> std::size_t {
+    std::size_t i = 0;
+    for (; period_available(i, count); i += kPeriodRecords) {
+      for (std::size_t v = 0; v < kTableVectors; ++v) {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dst + i * kDstSize +
+                                       v * kShuffleLaneSize),
+            shuffle_vector_ssse3(kShuffles.vectors[v], src + i * kSrcSize));
+      }
+    }
+    return i;
+  }
+
+  // Two adjacent source windows, one per 128-bit half.
+  __attribute__((target("avx2"))) static auto load_window_pair(
+      const unsigned char* low, const unsigned char* high) -> __m256i {
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(low))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(high)), 1);
+  }
+
+  __attribute__((target("avx2"))) static auto load_shuffle(
+      const unsigned char* shuffle) -> __m256i {
+    return _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle)));
+  }
+
+  // vpshufb shuffles within each 128-bit half, so the upper half converts
+  // the same vector of the next period with the same shuffle.
+  __attribute__((target("avx2"))) static auto convert_avx2(
+      const unsigned char* src, unsigned char* dst, std::size_t count)
+      -> std::size_t {
+    constexpr std::size_t kPeriodSrcSize = kPeriodRecords * kSrcSize;
+    std::size_t i = 0;
+    for (; period_available(i + kPeriodRecords, count);
+         i += 2 * kPeriodRecords) {
+      const unsigned char* period_src = src + i * kSrcSize;
+      unsigned char* period_dst = dst + i * kDstSize;
+      for (std::size_t v = 0; v < kTableVectors; ++v) {
+        const ShuffleVector& vector = kShuffles.vectors[v];
+        const unsigned char* window = period_src + vector.src_offset;
+        __m256i converted = _mm256_shuffle_epi8(
+            load_window_pair(window, window + kPeriodSrcSize),
+            load_shuffle(vector.low));
+        if (vector.needs_high) {
+          converted = _mm256_or_si256(
+              converted,
+              _mm256_shuffle_epi8(
+                  load_window_pair(window + kShuffleLaneSize,
+                                   window + kPeriodSrcSize + kShuffleLaneSize),
+                  load_shuffle(vector.high)));
+        }
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(period_dst + v * kShuffleLaneSize),
+            _mm256_castsi256_si128(converted));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(
+                             period_dst + kPeriodSize + v * kShuffleLaneSize),
+                         _mm256_extracti128_si256(converted, 1));
+      }
+    }
+    return i;
+  }
+
+  static auto convert_vector(const unsigned char* src, unsigned char* dst,
+                             std::size_t count) -> std::size_t {
+    std::size_t converted = 0;
+    if (has_avx2()) {
+      converted = convert_avx2(src, dst, count);
+    }
+    if (has_ssse3()) {
+      converted += convert_ssse3(src + converted * kSrcSize,
+                                 dst + converted * kDstSize, count - converted);
+    }
+    return converted;
+  }
+#else
+  static auto convert_vector(const unsigned char* /*unused*/,
+                             unsigned char* /*unused*/,
+                             std::size_t /*unused*/) -> std::size_t {
+    return 0;
+  }
+#endif  // LITTLE_PP_IMPL_X86_SIMD
+
+  static void convert(const unsigned char* src, unsigned char* dst,
+                      std::size_t count) {
+    if (Plan::kIsSingleCopy) {
+      // memcpy's pointers must not be null, even for 0 bytes
+      if (count > 0) {
+        std::memcpy(dst, src, count * kSrcSize);
+      }
+      return;
+    }
+    std::size_t converted = 0;
+    if (kIsShuffleable) {
+      converted = convert_vector(src, dst, count);
+    }
+    convert_scalar(src + converted * kSrcSize, dst + converted * kDstSize,
+                   count - converted);
+  }
+};
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType, PaddingPolicy kPaddingPolicy>
+constexpr typename BatchConversion<SerializableClassType, SrcDataModelType,
+                                   DstDataModelType, kPaddingPolicy>::Shuffles
+    BatchConversion<SerializableClassType, SrcDataModelType, DstDataModelType,
+                    kPaddingPolicy>::kShuffles;
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_BATCH_CONVERSION_H
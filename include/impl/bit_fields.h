@@ -0,0 +1,109 @@
+// ABOUT: Sub-byte fields packed into one storage word. The bit offset of each
+//        field is the sum of the widths before it (the first field occupies
+//        the least significant bits), so every access is a constant mask and
+//        shift of the word.
+//
+//        The layout engine treats a BitFields member as a single scalar of its
+//        storage type: the data model decides the word's size and byte order,
+//        and the serializer converts the whole word at once regardless of how
+//        many fields it holds.
+
+#ifndef LITTLE_PP_IMPL_BIT_FIELDS_H
+#define LITTLE_PP_IMPL_BIT_FIELDS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace litte_pp {
+
+namespace impl {
+
+template <typename StorageType, std::size_t... kWidths>
+struct BitFields {
+  static_assert(std::is_integral<StorageType>::value &&
+                    std::is_unsigned<StorageType>::value &&
+                    !std::is_same<StorageType, bool>::value,
+                "BitFields storage must be an unsigned integer type.");
+
+  static constexpr std::size_t kFieldCount = sizeof...(kWidths);
+  static constexpr std::size_t kStorageBits =
+      std::numeric_limits<StorageType>::digits;
+
+  static constexpr auto get_width(std::size_t index) -> std::size_t {
+    const std::size_t widths[] = {0, kWidths...};
+    return widths[index + 1];
+  }
+
+  static constexpr auto get_offset(std::size_t index) -> std::size_t {
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < index; ++i) {
+      offset += get_width(i);
+    }
+    return offset;
+  }
+
+  static_assert(get_offset(kFieldCount) <= kStorageBits,
+                "BitFields widths exceed the storage type.");
+
+  // The mask of field `index`, not yet shifted to its offset.
+  static constexpr auto get_mask(std::size_t index) -> StorageType {
+    return (get_width(index) >= kStorageBits)
+               ? std::numeric_limits<StorageType>::max()
+               : static_cast<StorageType>((StorageType{1} << get_width(index)) -
+                                          1U);
+  }
+
+  template <std::size_t I>
+  constexpr auto get() const -> StorageType {
+    static_assert(I < kFieldCount, "Bit field index out of range.");
+    return static_cast<StorageType>(bits >> get_offset(I)) & get_mask(I);
+  }
+
+  // Bits of `value` beyond the field's width are discarded.
+  template <std::size_t I>
+  constexpr void set(StorageType value) {
+    static_assert(I < kFieldCount, "Bit field index out of range.");
+    bits = static_cast<StorageType>(
+        (bits & static_cast<StorageType>(~(get_mask(I) << get_offset(I)))) |
+        ((value & get_mask(I)) << get_offset(I)));
+  }
+
+  template <typename... Values>
+  static constexpr auto pack(Values... values) -> BitFields {
+    static_assert(sizeof...(Values) == kFieldCount,
+                  "pack takes one value per bit field.");
+    return pack(std::make_index_sequence<kFieldCount>{},
+                static_cast<StorageType>(values)...);
+  }
+
+  // The raw storage word; the only data member, so BitFields stays an
+  // aggregate and its size and alignment are the storage type's.
+  StorageType bits;
+
+ private:
+  template <std::size_t... I, typename... Values>
+  static constexpr auto pack(std::index_sequence<I...> /*unused*/,
+                             Values... values) -> BitFields {
+    StorageType word = 0;
+    using Expander = int[];
+    (void)Expander{0, (word = static_cast<StorageType>(
+                           word | ((values & get_mask(I)) << get_offset(I))),
+                       0)...};
+    return BitFields{word};
+  }
+};
+
+template <typename T>
+struct IsBitFields : std::false_type {};
+
+template <typename StorageType, std::size_t... kWidths>
+struct IsBitFields<BitFields<StorageType, kWidths...>> : std::true_type {};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_BIT_FIELDS_H
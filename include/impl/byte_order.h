@@ -0,0 +1,105 @@
+// ABOUT: Byte-level loads and stores of integers in an explicit byte order.
+//        Every function is templated on the (compile-time) width so the byte
+//        loops fully unroll; GCC and Clang fold them into a single load or
+//        store plus a bswap where the byte order differs from the host's.
+
+#ifndef LITTLE_PP_IMPL_BYTE_ORDER_H
+#define LITTLE_PP_IMPL_BYTE_ORDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "../data_model.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+constexpr std::size_t kBitsPerByte = 8;
+
+template <std::size_t kSize>
+constexpr auto byte_shift(std::size_t index, little_pp::Endianess endianess)
+    -> std::size_t {
+  return (endianess == little_pp::Endianess::kLittleEndian)
+             ? index * kBitsPerByte
+             : (kSize - 1 - index) * kBitsPerByte;
+}
+
+// The byte helpers are templated on the byte type so they also operate on
+// volatile memory, one byte access per byte. The byte loops are expanded
+// explicitly: GCC at -O2 does not unroll them when the caller is itself a loop
+// (e.g. over records), which leaves a shift per byte instead of a bswap.
+template <std::size_t kSize, little_pp::Endianess kEndianess,
+          typename ByteType, std::size_t... I>
+inline auto load_uint(const ByteType* bytes,
+                      std::index_sequence<I...> /*unused*/) -> std::uint64_t {
+  std::uint64_t value = 0;
+  using Expander = int[];
+  (void)Expander{0, (value |= static_cast<std::uint64_t>(bytes[I])
+                              << byte_shift<kSize>(I, kEndianess),
+                     0)...};
+  return value;
+}
+
+template <std::size_t kSize, little_pp::Endianess kEndianess,
+          typename ByteType>
+inline auto load_uint(const ByteType* bytes) -> std::uint64_t {
+  static_assert(kSize <= sizeof(std::uint64_t),
+                "Integers wider than 64 bits are not supported.");
+  return load_uint<kSize, kEndianess>(bytes,
+                                      std::make_index_sequence<kSize>{});
+}
+
+template <std::size_t kSize, little_pp::Endianess kEndianess,
+          typename ByteType, std::size_t... I>
+inline void store_uint(ByteType* bytes, std::uint64_t value,
+                       std::index_sequence<I...> /*unused*/) {
+  using Expander = int[];
+  (void)Expander{0, (bytes[I] = static_cast<unsigned char>(
+                         value >> byte_shift<kSize>(I, kEndianess)),
+                     0)...};
+}
+
+template <std::size_t kSize, little_pp::Endianess kEndianess,
+          typename ByteType>
+inline void store_uint(ByteType* bytes, std::uint64_t value) {
+  static_assert(kSize <= sizeof(std::uint64_t),
+                "Integers wider than 64 bits are not supported.");
+  store_uint<kSize, kEndianess>(bytes, value,
+                                std::make_index_sequence<kSize>{});
+}
+
+// Sign-extends the low kSize bytes of value to 64 bits.
+template <std::size_t kSize>
+constexpr auto sign_extend(std::uint64_t value) -> std::uint64_t {
+  // (value ^ sign_bit) - sign_bit avoids implementation-defined shifts of
+  // negative numbers.
+  return (kSize >= sizeof(std::uint64_t))
+             ? value
+             : (value ^ (std::uint64_t{1} << (kSize * kBitsPerByte - 1))) -
+                   (std::uint64_t{1} << (kSize * kBitsPerByte - 1));
+}
+
+template <std::size_t kSize, typename SrcByteType, typename DstByteType>
+inline void copy_reversed(const SrcByteType* src, DstByteType* dst) {
+  for (std::size_t i = 0; i < kSize; ++i) {
+    dst[i] = src[kSize - 1 - i];
+  }
+}
+
+// A byte loop rather than memcpy so that either side may be volatile;
+// compilers emit memcpy for the non-volatile case anyway.
+template <std::size_t kSize, typename SrcByteType, typename DstByteType>
+inline void copy_forward(const SrcByteType* src, DstByteType* dst) {
+  for (std::size_t i = 0; i < kSize; ++i) {
+    dst[i] = src[i];
+  }
+}
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_BYTE_ORDER_H
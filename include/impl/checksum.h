@@ -0,0 +1,243 @@
+// ABOUT: Checksums over serialized bytes. Every checksum is a small value
+//        type with the same interface, so the serializer can update it run by
+//        run (see checksummed_conversion.h):
+//
+//          using Value = ...;                   // the checksum's value
+//          static constexpr std::size_t kSize;  // its serialized size
+//          void update(const unsigned char* bytes, std::size_t size);
+//          void update_zeros(std::size_t size); // as update() of zero bytes
+//          auto get_value() const -> Value;
+//
+//        update_zeros() never touches memory: zeroed padding is folded in
+//        from the layout instead of being read back.
+//
+//        - Crc32c: CRC-32C (Castagnoli), with SSE4.2's crc32 instruction when
+//          the CPU has it (checked at runtime unless the build targets
+//          SSE4.2) and a table otherwise.
+//        - Crc16Ccitt: CRC-16/CCITT-FALSE, table-driven.
+//        - Fletcher16: Fletcher's checksum over bytes, modulo 255; a run of
+//          zeros is folded in O(1).
+
+#ifndef LITTLE_PP_IMPL_CHECKSUM_H
+#define LITTLE_PP_IMPL_CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "field_layout.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define LITTLE_PP_IMPL_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace litte_pp {
+
+namespace impl {
+
+#ifdef LITTLE_PP_IMPL_X86_SIMD
+// Queried once, as in batch_conversion.h; checksums are created per frame.
+inline auto has_sse42() -> bool {
+  static const bool has = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2") != 0;
+  }();
+  return has;
+}
+#endif  // LITTLE_PP_IMPL_X86_SIMD
+
+// The byte-at-a-time table of a CRC: reflected CRCs shift right, the others
+// left.
+template <typename Word, Word kPolynomial, bool kIsReflected>
+struct CrcTable {
+  static constexpr std::size_t kWordBits = sizeof(Word) * 8;
+  static constexpr Word kTopBit = static_cast<Word>(Word{1} << (kWordBits - 1));
+
+  static constexpr auto make_entry(Word index) -> Word {
+    Word crc =
+        kIsReflected ? index : static_cast<Word>(index << (kWordBits - 8));
+    for (int bit = 0; bit < 8; ++bit) {
+      if (kIsReflected) {
+        crc = static_cast<Word>((crc & 1U) ? (crc >> 1) ^ kPolynomial
+                                           : crc >> 1);
+      } else {
+        crc = static_cast<Word>((crc & kTopBit) ? (crc << 1) ^ kPolynomial
+                                                : crc << 1);
+      }
+    }
+    return crc;
+  }
+
+  static constexpr auto make_entries() -> ConstexprArray<Word, 256> {
+    ConstexprArray<Word, 256> entries{};
+    for (std::size_t i = 0; i < 256; ++i) {
+      entries[i] = make_entry(static_cast<Word>(i));
+    }
+    return entries;
+  }
+
+  static constexpr ConstexprArray<Word, 256> kEntries = make_entries();
+
+  static auto update(Word crc, unsigned char byte) -> Word {
+    if (kIsReflected) {
+      return static_cast<Word>(kEntries[(crc ^ byte) & 0xFFU] ^ (crc >> 8));
+    }
+    return static_cast<Word>(
+        kEntries[((crc >> (kWordBits - 8)) ^ byte) & 0xFFU] ^ (crc << 8));
+  }
+};
+
+template <typename Word, Word kPolynomial, bool kIsReflected>
+constexpr ConstexprArray<Word, 256>
+    CrcTable<Word, kPolynomial, kIsReflected>::kEntries;
+
+class Crc32c {
+ public:
+  using Value = std::uint32_t;
+  static constexpr std::size_t kSize = sizeof(Value);
+
+  void update(const unsigned char* bytes, std::size_t size) {
+#ifdef LITTLE_PP_IMPL_X86_SIMD
+    if (is_sse42_used()) {
+      crc_ = update_sse42(crc_, bytes, size);
+      return;
+    }
+#endif
+    for (std::size_t i = 0; i < size; ++i) {
+      crc_ = Table::update(crc_, bytes[i]);
+    }
+  }
+
+  void update_zeros(std::size_t size) {
+#ifdef LITTLE_PP_IMPL_X86_SIMD
+    if (is_sse42_used()) {
+      crc_ = update_zeros_sse42(crc_, size);
+      return;
+    }
+#endif
+    for (std::size_t i = 0; i < size; ++i) {
+      crc_ = Table::update(crc_, 0);
+    }
+  }
+
+  auto get_value() const -> Value { return crc_ ^ 0xFFFFFFFFU; }
+
+ private:
+  using Table = CrcTable<std::uint32_t, 0x82F63B78U, true>;
+
+#ifdef LITTLE_PP_IMPL_X86_SIMD
+  static auto is_sse42_used() -> bool {
+#ifdef __SSE4_2__
+    return true;
+#else
+    return has_sse42();
+#endif
+  }
+
+  __attribute__((target("sse4.2"))) static auto update_sse42(
+      std::uint32_t crc, const unsigned char* bytes, std::size_t size)
+      -> std::uint32_t {
+    std::size_t i = 0;
+#ifdef __x86_64__
+    std::uint64_t wide_crc = crc;
+    for (; i + 8 <= size; i += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, bytes + i, sizeof(word));
+      wide_crc = _mm_crc32_u64(wide_crc, word);
+    }
+    crc = static_cast<std::uint32_t>(wide_crc);
+#endif
+    for (; i + 4 <= size; i += 4) {
+      std::uint32_t word;
+      std::memcpy(&word, bytes + i, sizeof(word));
+      crc = _mm_crc32_u32(crc, word);
+    }
+    for (; i < size; ++i) {
+      crc = _mm_crc32_u8(crc, bytes[i]);
+    }
+    return crc;
+  }
+
+  __attribute__((target("sse4.2"))) static auto update_zeros_sse42(
+      std::uint32_t crc, std::size_t size) -> std::uint32_t {
+    for (; size >= 4; size -= 4) {
+      crc = _mm_crc32_u32(crc, 0);
+    }
+    for (; size > 0; --size) {
+      crc = _mm_crc32_u8(crc, 0);
+    }
+    return crc;
+  }
+#endif  // LITTLE_PP_IMPL_X86_SIMD
+
+  std::uint32_t crc_ = 0xFFFFFFFFU;
+};
+
+class Crc16Ccitt {
+ public:
+  using Value = std::uint16_t;
+  static constexpr std::size_t kSize = sizeof(Value);
+
+  void update(const unsigned char* bytes, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      crc_ = Table::update(crc_, bytes[i]);
+    }
+  }
+
+  void update_zeros(std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      crc_ = Table::update(crc_, 0);
+    }
+  }
+
+  auto get_value() const -> Value { return crc_; }
+
+ private:
+  using Table = CrcTable<std::uint16_t, 0x1021U, false>;
+
+  std::uint16_t crc_ = 0xFFFFU;
+};
+
+class Fletcher16 {
+ public:
+  using Value = std::uint16_t;
+  static constexpr std::size_t kSize = sizeof(Value);
+
+  void update(const unsigned char* bytes, std::size_t size) {
+    while (size > 0) {
+      const std::size_t block = (size < kMaxBlock) ? size : kMaxBlock;
+      for (std::size_t i = 0; i < block; ++i) {
+        sum1_ += bytes[i];
+        sum2_ += sum1_;
+      }
+      sum1_ %= 255;
+      sum2_ %= 255;
+      bytes += block;
+      size -= block;
+    }
+  }
+
+  // Zeros leave the first sum alone and add it to the second once per byte.
+  void update_zeros(std::size_t size) {
+    sum2_ = static_cast<std::uint32_t>((sum2_ + (size % 255) * sum1_) % 255);
+  }
+
+  auto get_value() const -> Value {
+    return static_cast<Value>((sum2_ << 8) | sum1_);
+  }
+
+ private:
+  // The most bytes the 32-bit sums take between reductions without
+  // overflowing.
+  static constexpr std::size_t kMaxBlock = 5802;
+
+  std::uint32_t sum1_ = 0;
+  std::uint32_t sum2_ = 0;
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_CHECKSUM_H
@@ -0,0 +1,162 @@
+// ABOUT: Conversion fused with a checksum over the serialized side, so a
+//        frame and its trailing checksum are produced (or verified) in one
+//        pass. The CopyPlan's runs are expanded as in CopyPlan::apply, and
+//        after each run the checksum is updated with the bytes the run just
+//        wrote (serializing) or read (verifying), while they are still in L1.
+//
+//        The serialized side must be summed in offset order. Runs are ordered
+//        by destination offset and, since leaves keep their order in every
+//        layout, by source offset too; the bytes between runs are computed at
+//        compile time:
+//          - destination padding written by a kZero run is folded in with
+//            update_zeros(), without reading it back;
+//          - destination padding no run writes (kPreserve) and source
+//            padding are summed from the buffer, as they are part of the
+//            frame.
+//        Signing therefore reads the destination's padding, which kSkip
+//        promises never to do, so it is rejected there.
+//        The checksum follows the serialized object, in the serialized data
+//        model's byte order.
+
+#ifndef LITTLE_PP_IMPL_CHECKSUMMED_CONVERSION_H
+#define LITTLE_PP_IMPL_CHECKSUMMED_CONVERSION_H
+
+#include <cstddef>
+#include <utility>
+
+#include "byte_order.h"
+#include "layout.h"
+#include "serialization.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+template <typename ChecksumType, typename SerializableClassType,
+          typename SrcDataModelType, typename DstDataModelType,
+          PaddingPolicy kPaddingPolicy = PaddingPolicy::kZero>
+struct ChecksummedConversion {
+  using Plan = CopyPlan<SerializableClassType, SrcDataModelType,
+                        DstDataModelType, kPaddingPolicy>;
+  static constexpr std::size_t kSrcSize =
+      Layout<SerializableClassType, SrcDataModelType>::kSize;
+  static constexpr std::size_t kDstSize =
+      Layout<SerializableClassType, DstDataModelType>::kSize;
+
+  // The end of the destination bytes written by the runs before run i.
+  static constexpr auto get_dst_covered(std::size_t i) -> std::size_t {
+    return (i == 0)
+               ? 0
+               : Plan::kRuns[i - 1].dst_offset + Plan::kRuns[i - 1].dst_size;
+  }
+
+  // The end of the source bytes read by the runs before run i.
+  static constexpr auto get_src_covered(std::size_t i) -> std::size_t {
+    std::size_t covered = 0;
+    for (std::size_t r = 0; r < i; ++r) {
+      if (Plan::kRuns[r].kind != RunKind::kZero) {
+        covered = Plan::kRuns[r].src_offset + Plan::kRuns[r].src_size;
+      }
+    }
+    return covered;
+  }
+
+  static constexpr auto is_src_ordered() -> bool {
+    for (std::size_t i = 0; i < Plan::kRunCount; ++i) {
+      if (Plan::kRuns[i].kind != RunKind::kZero &&
+          Plan::kRuns[i].src_offset < get_src_covered(i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static_assert(is_src_ordered(),
+                "The plan's runs must read the source in offset order.");
+
+  template <std::size_t I>
+  static void convert_run_summing_dst(const unsigned char* src,
+                                      unsigned char* dst,
+                                      ChecksumType& checksum) {
+    constexpr CopyRun kRun = Plan::kRuns[I];
+    constexpr std::size_t kCovered = get_dst_covered(I);
+    if (kRun.dst_offset > kCovered) {
+      checksum.update(dst + kCovered, kRun.dst_offset - kCovered);
+    }
+    Plan::template write_run<I>(src, dst + kRun.dst_offset);
+    if (kRun.kind == RunKind::kZero) {
+      checksum.update_zeros(kRun.dst_size);
+    } else {
+      checksum.update(dst + kRun.dst_offset, kRun.dst_size);
+    }
+  }
+
+  template <std::size_t I>
+  static void convert_run_summing_src(const unsigned char* src,
+                                      unsigned char* dst,
+                                      ChecksumType& checksum) {
+    constexpr CopyRun kRun = Plan::kRuns[I];
+    constexpr std::size_t kCovered = get_src_covered(I);
+    Plan::template write_run<I>(src, dst + kRun.dst_offset);
+    if (kRun.kind == RunKind::kZero) {
+      return;
+    }
+    // source padding and the run are contiguous: one update
+    checksum.update(src + kCovered,
+                    kRun.src_offset + kRun.src_size - kCovered);
+  }
+
+  template <std::size_t... I>
+  static void convert_summing_dst(const unsigned char* src, unsigned char* dst,
+                                  ChecksumType& checksum,
+                                  std::index_sequence<I...> /*unused*/) {
+    using Expander = int[];
+    (void)Expander{0, (convert_run_summing_dst<I>(src, dst, checksum), 0)...};
+    constexpr std::size_t kCovered = get_dst_covered(sizeof...(I));
+    if (kDstSize > kCovered) {
+      checksum.update(dst + kCovered, kDstSize - kCovered);
+    }
+  }
+
+  template <std::size_t... I>
+  static void convert_summing_src(const unsigned char* src, unsigned char* dst,
+                                  ChecksumType& checksum,
+                                  std::index_sequence<I...> /*unused*/) {
+    using Expander = int[];
+    (void)Expander{0, (convert_run_summing_src<I>(src, dst, checksum), 0)...};
+    constexpr std::size_t kCovered = get_src_covered(sizeof...(I));
+    if (kSrcSize > kCovered) {
+      checksum.update(src + kCovered, kSrcSize - kCovered);
+    }
+  }
+
+  // Converts `src` into `dst` and stores the checksum of the kDstSize
+  // destination bytes right after them.
+  static void convert_and_sign(const unsigned char* src, unsigned char* dst) {
+    static_assert(kPaddingPolicy != PaddingPolicy::kSkip,
+                  "The checksum covers the destination's padding, which "
+                  "PaddingPolicy::kSkip never reads; use kZero or kPreserve.");
+    ChecksumType checksum;
+    convert_summing_dst(src, dst, checksum,
+                        std::make_index_sequence<Plan::kRunCount>{});
+    store_uint<ChecksumType::kSize, DstDataModelType::get_endianess()>(
+        dst + kDstSize, checksum.get_value());
+  }
+
+  // Converts `src` into `dst` and returns whether the checksum stored after
+  // the kSrcSize source bytes matches them. `dst` is written either way.
+  static auto convert_and_verify(const unsigned char* src, unsigned char* dst)
+      -> bool {
+    ChecksumType checksum;
+    convert_summing_src(src, dst, checksum,
+                        std::make_index_sequence<Plan::kRunCount>{});
+    return load_uint<ChecksumType::kSize, SrcDataModelType::get_endianess()>(
+               src + kSrcSize) == checksum.get_value();
+  }
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_CHECKSUMMED_CONVERSION_H
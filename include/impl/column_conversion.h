@@ -0,0 +1,260 @@
+// ABOUT: Deserialization of an array of records straight into one native
+//        column per field (array-of-structs to struct-of-arrays). Converting
+//        into records and transposing afterwards writes and re-reads every
+//        record once more; here each field is loaded from its serialized
+//        bytes, converting width and byte order, and stored directly into its
+//        column.
+//
+//        Records are converted a block at a time, column by column: a block
+//        of source records stays in L1 while every column is filled, and each
+//        column is written sequentially. Class members are converted with
+//        their own CopyPlan and std::array members element by element, so a
+//        column always holds the native field type.
+
+#ifndef LITTLE_PP_IMPL_COLUMN_CONVERSION_H
+#define LITTLE_PP_IMPL_COLUMN_CONVERSION_H
+
+#include <algorithm>
+#include <array>
+#include <boost/pfr/core.hpp>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "field_access.h"
+#include "field_layout.h"
+#include "layout.h"
+#include "native_layout.h"
+#include "serialization.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// Source bytes converted per block; well within any L1 data cache.
+constexpr std::size_t kColumnBlockBytes = std::size_t{16} * 1024;
+
+// A contiguous column of bools. std::vector<bool> packs its elements into
+// bits, so it has no data() to convert into.
+class BoolColumn {
+ public:
+  BoolColumn() = default;
+
+  BoolColumn(const BoolColumn& other) { *this = other; }
+  // A moved-from column is empty, like a moved-from std::vector.
+  BoolColumn(BoolColumn&& other) noexcept
+      : values_(std::move(other.values_)),
+        size_(std::exchange(other.size_, 0)) {}
+  auto operator=(const BoolColumn& other) -> BoolColumn& {
+    if (this != &other) {
+      resize(0);
+      resize(other.size_);
+      std::copy(other.begin(), other.end(), begin());
+    }
+    return *this;
+  }
+  auto operator=(BoolColumn&& other) noexcept -> BoolColumn& {
+    if (this != &other) {
+      values_ = std::move(other.values_);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  // Keeps the first `size` values; new values are false.
+  void resize(std::size_t size) {
+    std::unique_ptr<bool[]> values(size > 0 ? new bool[size]() : nullptr);
+    std::copy(begin(), begin() + std::min(size, size_), values.get());
+    values_ = std::move(values);
+    size_ = size;
+  }
+
+  auto size() const -> std::size_t { return size_; }
+  auto data() -> bool* { return values_.get(); }
+  auto data() const -> const bool* { return values_.get(); }
+  auto operator[](std::size_t i) -> bool& { return values_[i]; }
+  auto operator[](std::size_t i) const -> const bool& { return values_[i]; }
+  auto begin() -> bool* { return data(); }
+  auto begin() const -> const bool* { return data(); }
+  auto end() -> bool* { return data() + size_; }
+  auto end() const -> const bool* { return data() + size_; }
+
+ private:
+  std::unique_ptr<bool[]> values_;
+  std::size_t size_ = 0;
+};
+
+template <typename FieldType>
+struct OwnedColumn {
+  using Type = std::vector<FieldType>;
+};
+
+template <>
+struct OwnedColumn<bool> {
+  using Type = BoolColumn;
+};
+
+template <typename SerializableClassType,
+          typename = std::make_index_sequence<
+              boost::pfr::tuple_size_v<SerializableClassType>>>
+struct ColumnTypes;
+
+template <typename SerializableClassType, std::size_t... I>
+struct ColumnTypes<SerializableClassType, std::index_sequence<I...>> {
+  // caller-owned columns, one per field
+  using Pointers =
+      std::tuple<boost::pfr::tuple_element_t<I, SerializableClassType>*...>;
+  using Vectors = std::tuple<typename OwnedColumn<
+      boost::pfr::tuple_element_t<I, SerializableClassType>>::Type...>;
+};
+
+// Owns one std::vector (a BoolColumn for bool fields) per field of
+// SerializableClassType.
+template <typename SerializableClassType>
+class SoA {
+ public:
+  using ColumnPointers = typename ColumnTypes<SerializableClassType>::Pointers;
+  static constexpr std::size_t kColumnCount =
+      boost::pfr::tuple_size_v<SerializableClassType>;
+
+  SoA() = default;
+  explicit SoA(std::size_t size) { resize(size); }
+
+  SoA(const SoA&) = default;
+  // A moved-from SoA is empty, like its columns.
+  SoA(SoA&& other) noexcept
+      : columns_(std::move(other.columns_)),
+        size_(std::exchange(other.size_, 0)) {}
+  auto operator=(const SoA&) -> SoA& = default;
+  auto operator=(SoA&& other) noexcept -> SoA& {
+    if (this != &other) {
+      columns_ = std::move(other.columns_);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  void resize(std::size_t size) {
+    resize(size, std::make_index_sequence<kColumnCount>{});
+    size_ = size;
+  }
+
+  auto size() const -> std::size_t { return size_; }
+
+  template <std::size_t I>
+  auto get() -> std::tuple_element_t<
+      I, typename ColumnTypes<SerializableClassType>::Vectors>& {
+    return std::get<I>(columns_);
+  }
+
+  template <std::size_t I>
+  auto get() const -> const std::tuple_element_t<
+      I, typename ColumnTypes<SerializableClassType>::Vectors>& {
+    return std::get<I>(columns_);
+  }
+
+  auto get_column_pointers() -> ColumnPointers {
+    return get_column_pointers(std::make_index_sequence<kColumnCount>{});
+  }
+
+ private:
+  template <std::size_t... I>
+  void resize(std::size_t size, std::index_sequence<I...> /*unused*/) {
+    using Expander = int[];
+    (void)Expander{0, (std::get<I>(columns_).resize(size), 0)...};
+  }
+
+  template <std::size_t... I>
+  auto get_column_pointers(std::index_sequence<I...> /*unused*/)
+      -> ColumnPointers {
+    return ColumnPointers{std::get<I>(columns_).data()...};
+  }
+
+  typename ColumnTypes<SerializableClassType>::Vectors columns_;
+  std::size_t size_ = 0;
+};
+
+// Loads one member of any kind from its bytes in SrcDataModelType into its
+// native representation. The overloads are static members so that each one
+// can recurse into the others regardless of declaration order.
+template <typename SrcDataModelType, typename NativeDataModelType>
+struct MemberLoader {
+  template <typename MemberType>
+  static auto load(const unsigned char* src, MemberType& member) ->
+      typename std::enable_if<IsScalarField<MemberType>::kValue>::type {
+    member = load_field<MemberType,
+                        MemberLayout<MemberType, SrcDataModelType>::kSize,
+                        SrcDataModelType::get_endianess()>(src);
+  }
+
+  template <typename MemberType>
+  static auto load(const unsigned char* src, MemberType& member) ->
+      typename std::enable_if<IsNestedClass<MemberType>::kValue>::type {
+    CopyPlan<MemberType, SrcDataModelType, NativeDataModelType>::apply(
+        src, reinterpret_cast<unsigned char*>(&member));
+  }
+
+  template <typename ElementType, std::size_t N>
+  static void load(const unsigned char* src,
+                   std::array<ElementType, N>& member) {
+    for (std::size_t i = 0; i < N; ++i) {
+      load(src + i * MemberLayout<ElementType, SrcDataModelType>::kSize,
+           member[i]);
+    }
+  }
+};
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename NativeDataModelType>
+struct ColumnConversion {
+  using SrcLayout = Layout<SerializableClassType, SrcDataModelType>;
+  using ColumnPointers = typename ColumnTypes<SerializableClassType>::Pointers;
+  using Loader = MemberLoader<SrcDataModelType, NativeDataModelType>;
+
+  static constexpr std::size_t kSrcSize = SrcLayout::kSize;
+  static constexpr std::size_t kBlockRecordCount =
+      (kSrcSize == 0 || kSrcSize >= kColumnBlockBytes)
+          ? 1
+          : kColumnBlockBytes / kSrcSize;
+
+  template <std::size_t I>
+  static void convert_column(
+      const unsigned char* src, std::size_t count,
+      typename SrcLayout::template FieldType<I>* column) {
+    constexpr std::size_t kOffset = SrcLayout::kFields[I].offset;
+    for (std::size_t i = 0; i < count; ++i) {
+      Loader::load(src + i * kSrcSize + kOffset, column[i]);
+    }
+  }
+
+  template <std::size_t... I>
+  static void convert_block(const unsigned char* src, std::size_t count,
+                            std::size_t first_row,
+                            const ColumnPointers& columns,
+                            std::index_sequence<I...> /*unused*/) {
+    using Expander = int[];
+    (void)Expander{
+        0, (convert_column<I>(src, count, std::get<I>(columns) + first_row),
+            0)...};
+  }
+
+  static void convert(const unsigned char* src, std::size_t count,
+                      const ColumnPointers& columns) {
+    for (std::size_t first = 0; first < count; first += kBlockRecordCount) {
+      const std::size_t block_count = (count - first < kBlockRecordCount)
+                                          ? count - first
+                                          : kBlockRecordCount;
+      convert_block(src + first * kSrcSize, block_count, first, columns,
+                    std::make_index_sequence<SrcLayout::kFieldCount>{});
+    }
+  }
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_COLUMN_CONVERSION_H
@@ -0,0 +1,279 @@
+// ABOUT: Field-level delta encoding of a stream of objects. Every frame starts
+//        with a kind byte:
+//          - kKeyframe: followed by the whole object, serialized.
+//          - kDelta: followed by a bitmap with one bit per direct field (bit I
+//            in byte I / 8, least significant bit first) and then, in field
+//            order, the serialized bytes of every field whose bit is set.
+//        Fields are compared, and sent, in their serialized form: the encoder
+//        keeps the previous serialized object and a field changed iff its
+//        bytes differ. Wire padding is zeroed, including when identical
+//        layouts copy the object whole, so it never shows up as a change; a
+//        class member is sent whole when any of its fields changed.
+//
+//        The field count, the bitmap size and every field's offset and size
+//        are compile-time constants, so encoding and decoding expand to one
+//        fixed-size compare-and-copy per field.
+
+#ifndef LITTLE_PP_IMPL_DELTA_H
+#define LITTLE_PP_IMPL_DELTA_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "layout.h"
+#include "native_layout.h"
+#include "serialization.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+enum class DeltaFrameKind : unsigned char {
+  kKeyframe = 0x4B,  // 'K'
+  kDelta = 0x44,     // 'D'
+};
+
+template <typename SerializableClassType, typename WireDataModelType>
+struct DeltaFormat {
+  using WireLayout = Layout<SerializableClassType, WireDataModelType>;
+
+  static constexpr std::size_t kFieldCount = WireLayout::kFieldCount;
+  static constexpr std::size_t kBitmapSize = (kFieldCount + 7) / 8;
+  static constexpr std::size_t kSerializedSize = WireLayout::kSize;
+  static constexpr std::size_t kKeyframeSize = 1 + kSerializedSize;
+  // a delta of a frame in which every field changed
+  static constexpr std::size_t kMaxFrameSize =
+      1 + kBitmapSize + kSerializedSize;
+
+  static auto is_changed(const unsigned char* bitmap, std::size_t field)
+      -> bool {
+    return (bitmap[field / 8] & (1U << (field % 8))) != 0;
+  }
+
+  // Bits past the last field must be clear.
+  static auto has_stray_bits(const unsigned char* bitmap) -> bool {
+    return kFieldCount % 8 != 0 &&
+           (bitmap[kBitmapSize - 1] >> (kFieldCount % 8)) != 0;
+  }
+};
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename WireDataModelType>
+class DeltaEncoder {
+ public:
+  using Format = DeltaFormat<SerializableClassType, WireDataModelType>;
+  using WireLayout = typename Format::WireLayout;
+  using Plan =
+      CopyPlan<SerializableClassType, SrcDataModelType, WireDataModelType>;
+  static constexpr std::size_t kMaxFrameSize = Format::kMaxFrameSize;
+
+  // Every `keyframe_interval`-th frame is a keyframe; 0 only sends the first
+  // frame (and requested ones) as keyframes.
+  explicit DeltaEncoder(std::size_t keyframe_interval = 0)
+      : keyframe_interval_(keyframe_interval) {
+    static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                  "Serialized class type must be trivially copyable.");
+    static_assert(
+        NativeLayoutMatches<SerializableClassType, SrcDataModelType>::kValue,
+        "SrcDataModelType does not describe this architecture's layout of "
+        "the class.");
+  }
+
+  // Makes the next frame a keyframe, e.g. when a receiver (re)connects.
+  void request_keyframe() { is_keyframe_requested_ = true; }
+
+  // Encodes `object` into `frame`, which must hold kMaxFrameSize bytes.
+  // Returns the frame's size.
+  auto encode(const SerializableClassType& object, unsigned char* frame)
+      -> std::size_t {
+    unsigned char* current = serialized_[current_index_];
+    const unsigned char* previous = serialized_[1 - current_index_];
+    Plan::apply(reinterpret_cast<const unsigned char*>(&object), current);
+    if (Plan::kIsSingleCopy) {
+      // the whole-object copy brought the source's padding along
+      zero_padding(current,
+                   std::make_index_sequence<WireLayout::kPaddingRunCount>{});
+    }
+
+    const bool is_keyframe = is_keyframe_requested_ ||
+                             (keyframe_interval_ != 0 &&
+                              frames_since_keyframe_ >= keyframe_interval_);
+    std::size_t size = 0;
+    if (is_keyframe) {
+      frame[0] = static_cast<unsigned char>(DeltaFrameKind::kKeyframe);
+      std::memcpy(frame + 1, current, Format::kSerializedSize);
+      size = Format::kKeyframeSize;
+      is_keyframe_requested_ = false;
+      frames_since_keyframe_ = 1;
+    } else {
+      frame[0] = static_cast<unsigned char>(DeltaFrameKind::kDelta);
+      unsigned char* bitmap = frame + 1;
+      std::memset(bitmap, 0, Format::kBitmapSize);
+      size = encode_fields(current, previous, bitmap,
+                           1 + Format::kBitmapSize, frame,
+                           std::make_index_sequence<Format::kFieldCount>{});
+      frames_since_keyframe_++;
+    }
+    current_index_ = 1 - current_index_;
+    return size;
+  }
+
+ private:
+  template <std::size_t... I>
+  static void zero_padding(unsigned char* serialized,
+                           std::index_sequence<I...> /*unused*/) {
+    using Expander = int[];
+    (void)Expander{
+        0, (std::memset(serialized + WireLayout::kPaddingRuns[I].offset, 0,
+                        WireLayout::kPaddingRuns[I].size),
+            0)...};
+  }
+
+  template <std::size_t I>
+  static auto encode_field(const unsigned char* current,
+                           const unsigned char* previous,
+                           unsigned char* bitmap, std::size_t size,
+                           unsigned char* frame) -> std::size_t {
+    constexpr FieldLayout kField = WireLayout::kFields[I];
+    if (std::memcmp(current + kField.offset, previous + kField.offset,
+                    kField.size) == 0) {
+      return size;
+    }
+    bitmap[I / 8] =
+        static_cast<unsigned char>(bitmap[I / 8] | (1U << (I % 8)));
+    std::memcpy(frame + size, current + kField.offset, kField.size);
+    return size + kField.size;
+  }
+
+  template <std::size_t... I>
+  static auto encode_fields(const unsigned char* current,
+                            const unsigned char* previous,
+                            unsigned char* bitmap, std::size_t size,
+                            unsigned char* frame,
+                            std::index_sequence<I...> /*unused*/)
+      -> std::size_t {
+    using Expander = std::size_t[];
+    (void)Expander{0, (size = encode_field<I>(current, previous, bitmap,
+                                              size, frame))...};
+    return size;
+  }
+
+  std::size_t keyframe_interval_;
+  std::size_t frames_since_keyframe_ = 0;
+  bool is_keyframe_requested_ = true;
+  // the current and the previous object, serialized; they swap every frame
+  unsigned char serialized_[2][(Format::kSerializedSize > 0)
+                                   ? Format::kSerializedSize
+                                   : 1] = {};
+  std::size_t current_index_ = 0;
+};
+
+template <typename SerializableClassType, typename WireDataModelType,
+          typename DstDataModelType>
+class DeltaDecoder {
+ public:
+  using Format = DeltaFormat<SerializableClassType, WireDataModelType>;
+  using WireLayout = typename Format::WireLayout;
+  static constexpr std::size_t kMaxFrameSize = Format::kMaxFrameSize;
+
+  DeltaDecoder() {
+    static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                  "Deserialized class type must be trivially copyable.");
+    static_assert(
+        NativeLayoutMatches<SerializableClassType, DstDataModelType>::kValue,
+        "DstDataModelType does not describe this architecture's layout of "
+        "the class.");
+  }
+
+  // Whether a keyframe was decoded, i.e. deltas can be applied.
+  auto is_synchronized() const -> bool { return is_synchronized_; }
+
+  // Forgets the current object; the next frame must be a keyframe.
+  void reset() { is_synchronized_ = false; }
+
+  // Decodes the frame at the start of `frame` (`size` bytes available) into
+  // `object`. Returns the frame's size, or 0 if the frame is truncated,
+  // malformed, or a delta while not synchronized; `object` is only written
+  // when a frame is decoded.
+  auto decode(const unsigned char* frame, std::size_t size,
+              SerializableClassType& object) -> std::size_t {
+    if (size < 1) {
+      return 0;
+    }
+    std::size_t frame_size = 0;
+    if (frame[0] == static_cast<unsigned char>(DeltaFrameKind::kKeyframe)) {
+      if (size < Format::kKeyframeSize) {
+        return 0;
+      }
+      std::memcpy(serialized_, frame + 1, Format::kSerializedSize);
+      is_synchronized_ = true;
+      frame_size = Format::kKeyframeSize;
+    } else if (frame[0] == static_cast<unsigned char>(DeltaFrameKind::kDelta)) {
+      if (!is_synchronized_ || size < 1 + Format::kBitmapSize ||
+          Format::has_stray_bits(frame + 1)) {
+        return 0;
+      }
+      const unsigned char* bitmap = frame + 1;
+      frame_size = get_delta_size(
+          bitmap, std::make_index_sequence<Format::kFieldCount>{});
+      if (size < frame_size) {
+        return 0;
+      }
+      decode_fields(bitmap, frame,
+                    std::make_index_sequence<Format::kFieldCount>{});
+    } else {
+      return 0;
+    }
+    CopyPlan<SerializableClassType, WireDataModelType,
+             DstDataModelType>::apply(serialized_,
+                                      reinterpret_cast<unsigned char*>(
+                                          &object));
+    return frame_size;
+  }
+
+ private:
+  template <std::size_t... I>
+  static auto get_delta_size(const unsigned char* bitmap,
+                             std::index_sequence<I...> /*unused*/)
+      -> std::size_t {
+    std::size_t size = 1 + Format::kBitmapSize;
+    using Expander = std::size_t[];
+    (void)Expander{0, (size += Format::is_changed(bitmap, I)
+                                   ? WireLayout::kFields[I].size
+                                   : 0)...};
+    return size;
+  }
+
+  template <std::size_t I>
+  auto decode_field(const unsigned char* bitmap, const unsigned char* frame,
+                    std::size_t offset) -> std::size_t {
+    constexpr FieldLayout kField = WireLayout::kFields[I];
+    if (!Format::is_changed(bitmap, I)) {
+      return offset;
+    }
+    std::memcpy(serialized_ + kField.offset, frame + offset, kField.size);
+    return offset + kField.size;
+  }
+
+  template <std::size_t... I>
+  void decode_fields(const unsigned char* bitmap, const unsigned char* frame,
+                     std::index_sequence<I...> /*unused*/) {
+    std::size_t offset = 1 + Format::kBitmapSize;
+    using Expander = std::size_t[];
+    (void)Expander{0, (offset = decode_field<I>(bitmap, frame, offset))...};
+    (void)offset;  // unused when the class has no fields
+  }
+
+  bool is_synchronized_ = false;
+  unsigned char serialized_[(Format::kSerializedSize > 0)
+                                ? Format::kSerializedSize
+                                : 1] = {};
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_DELTA_H
@@ -0,0 +1,159 @@
+// ABOUT: Loads and stores of a single native field value from/to its
+//        serialized bytes, converting width and byte order on the way. Used
+//        by the views that access fields in place instead of converting the
+//        whole class. The serialized bytes may be volatile.
+
+#ifndef LITTLE_PP_IMPL_FIELD_ACCESS_H
+#define LITTLE_PP_IMPL_FIELD_ACCESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "../data_model.h"
+#include "byte_order.h"
+#include "field_layout.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// Reinterprets the low sizeof(FieldType) bytes of `value` as a FieldType.
+template <typename FieldType>
+inline auto from_uint(std::uint64_t value) ->
+    typename std::enable_if<std::is_same<FieldType, bool>::value,
+                            FieldType>::type {
+  return value != 0;
+}
+
+template <typename FieldType>
+inline auto from_uint(std::uint64_t value) ->
+    typename std::enable_if<!std::is_same<FieldType, bool>::value &&
+                                !std::is_floating_point<FieldType>::value &&
+                                !IsBitFields<FieldType>::value,
+                            FieldType>::type {
+  // narrowing to a signed type wraps modulo 2^N on every supported compiler
+  return static_cast<FieldType>(
+      static_cast<typename FieldScalar<FieldType>::Type>(value));
+}
+
+template <typename FieldType>
+inline auto from_uint(std::uint64_t value) ->
+    typename std::enable_if<IsBitFields<FieldType>::value, FieldType>::type {
+  return FieldType{static_cast<typename FieldScalar<FieldType>::Type>(value)};
+}
+
+template <typename FieldType>
+inline auto from_uint(std::uint64_t value) ->
+    typename std::enable_if<std::is_floating_point<FieldType>::value,
+                            FieldType>::type {
+  unsigned char bytes[sizeof(FieldType)];
+  store_uint<sizeof(FieldType),
+             little_pp::get_this_architecture_endianess()>(bytes, value);
+  FieldType field;
+  std::memcpy(&field, bytes, sizeof(FieldType));
+  return field;
+}
+
+template <typename FieldType>
+inline auto to_uint(const FieldType& field) ->
+    typename std::enable_if<!std::is_floating_point<FieldType>::value &&
+                                !IsBitFields<FieldType>::value,
+                            std::uint64_t>::type {
+  // sign-extends signed values, which is what widening requires
+  return static_cast<std::uint64_t>(
+      static_cast<typename FieldScalar<FieldType>::Type>(field));
+}
+
+template <typename FieldType>
+inline auto to_uint(const FieldType& field) ->
+    typename std::enable_if<IsBitFields<FieldType>::value,
+                            std::uint64_t>::type {
+  return field.bits;
+}
+
+template <typename FieldType>
+inline auto to_uint(const FieldType& field) ->
+    typename std::enable_if<std::is_floating_point<FieldType>::value,
+                            std::uint64_t>::type {
+  unsigned char bytes[sizeof(FieldType)];
+  std::memcpy(bytes, &field, sizeof(FieldType));
+  return load_uint<sizeof(FieldType),
+                   little_pp::get_this_architecture_endianess()>(bytes);
+}
+
+template <typename FieldType, std::size_t kSize,
+          little_pp::Endianess kEndianess, typename ByteType>
+inline auto load_field(const ByteType* bytes) ->
+    typename std::enable_if<(kSize <= sizeof(std::uint64_t) &&
+                             sizeof(FieldType) <= sizeof(std::uint64_t)),
+                            FieldType>::type {
+  constexpr ValueKind kValueKind = FieldValueKind<FieldType>::kValue;
+  static_assert(kValueKind != ValueKind::kFloatingPoint ||
+                    kSize == sizeof(FieldType),
+                "Converting the width of a floating-point field is not "
+                "supported.");
+  std::uint64_t value = load_uint<kSize, kEndianess>(bytes);
+  if (kValueKind == ValueKind::kSigned) {
+    value = sign_extend<kSize>(value);
+  }
+  return from_uint<FieldType>(value);
+}
+
+// Fields wider than 64 bits (e.g. long double) can only change byte order.
+template <typename FieldType, std::size_t kSize,
+          little_pp::Endianess kEndianess, typename ByteType>
+inline auto load_field(const ByteType* bytes) ->
+    typename std::enable_if<!(kSize <= sizeof(std::uint64_t) &&
+                              sizeof(FieldType) <= sizeof(std::uint64_t)),
+                            FieldType>::type {
+  static_assert(kSize == sizeof(FieldType),
+                "Converting the width of a field wider than 64 bits is not "
+                "supported.");
+  FieldType field;
+  if (kEndianess == little_pp::get_this_architecture_endianess()) {
+    copy_forward<kSize>(bytes, reinterpret_cast<unsigned char*>(&field));
+  } else {
+    copy_reversed<kSize>(bytes, reinterpret_cast<unsigned char*>(&field));
+  }
+  return field;
+}
+
+template <typename FieldType, std::size_t kSize,
+          little_pp::Endianess kEndianess, typename ByteType>
+inline auto store_field(ByteType* bytes, const FieldType& field) ->
+    typename std::enable_if<(kSize <= sizeof(std::uint64_t) &&
+                             sizeof(FieldType) <=
+                                 sizeof(std::uint64_t))>::type {
+  static_assert(FieldValueKind<FieldType>::kValue !=
+                        ValueKind::kFloatingPoint ||
+                    kSize == sizeof(FieldType),
+                "Converting the width of a floating-point field is not "
+                "supported.");
+  // narrowing keeps the low-order bytes, like a static_cast
+  store_uint<kSize, kEndianess>(bytes, to_uint(field));
+}
+
+template <typename FieldType, std::size_t kSize,
+          little_pp::Endianess kEndianess, typename ByteType>
+inline auto store_field(ByteType* bytes, const FieldType& field) ->
+    typename std::enable_if<!(kSize <= sizeof(std::uint64_t) &&
+                              sizeof(FieldType) <=
+                                  sizeof(std::uint64_t))>::type {
+  static_assert(kSize == sizeof(FieldType),
+                "Converting the width of a field wider than 64 bits is not "
+                "supported.");
+  if (kEndianess == little_pp::get_this_architecture_endianess()) {
+    copy_forward<kSize>(reinterpret_cast<const unsigned char*>(&field), bytes);
+  } else {
+    copy_reversed<kSize>(reinterpret_cast<const unsigned char*>(&field),
+                         bytes);
+  }
+}
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_FIELD_ACCESS_H
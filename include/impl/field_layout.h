@@ -0,0 +1,124 @@
+// ABOUT: Building blocks for the layout computation (see layout.h): a
+//        constexpr-writable array, alignment arithmetic, and how a scalar
+//        field's type is looked up in a data model and interpreted on
+//        conversion.
+
+#ifndef LITTLE_PP_IMPL_FIELD_LAYOUT_H
+#define LITTLE_PP_IMPL_FIELD_LAYOUT_H
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "bit_fields.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// std::array's non-const accessors are not constexpr until C++17, so tables
+// that are filled by constexpr loops use this minimal array instead.
+template <typename T, std::size_t N>
+struct ConstexprArray {
+  // A zero-length C array is ill-formed; keep one unused element instead.
+  T values[(N > 0) ? N : 1];
+
+  constexpr auto operator[](std::size_t i) -> T& { return values[i]; }
+  constexpr auto operator[](std::size_t i) const -> const T& {
+    return values[i];
+  }
+  static constexpr auto size() -> std::size_t { return N; }
+};
+
+template <typename T, std::size_t N, std::size_t... I>
+constexpr auto to_std_array(const ConstexprArray<T, N>& array,
+                            std::index_sequence<I...> /*unused*/)
+    -> std::array<T, N> {
+  return std::array<T, N>{{array[I]...}};
+}
+
+template <typename T, std::size_t N>
+constexpr auto to_std_array(const ConstexprArray<T, N>& array)
+    -> std::array<T, N> {
+  return to_std_array(array, std::make_index_sequence<N>{});
+}
+
+template <typename T>
+struct IsSerializableType {
+  static constexpr bool kValue = std::is_arithmetic<T>::value ||
+                                 std::is_enum<T>::value ||
+                                 std::is_class<T>::value;
+};
+
+constexpr auto align_up(std::size_t value, std::size_t alignment)
+    -> std::size_t {
+  // an empty struct has an alignment of 0; nothing needs aligning
+  return (alignment == 0) ? value
+                          : (value + alignment - 1) / alignment * alignment;
+}
+
+// How a field's value is interpreted when its width or byte order changes.
+enum class ValueKind {
+  kUnsigned,
+  kSigned,
+  kFloatingPoint,
+};
+
+// The type a field is looked up as in the data model; enums are represented by
+// their underlying type.
+template <typename FieldType, typename = void>
+struct FieldScalar {
+  using Type = FieldType;
+};
+
+template <typename FieldType>
+struct FieldScalar<
+    FieldType, typename std::enable_if<std::is_enum<FieldType>::value>::type> {
+  using Type = typename std::underlying_type<FieldType>::type;
+};
+
+// A BitFields member is converted as its storage word.
+template <typename FieldType>
+struct FieldScalar<
+    FieldType, typename std::enable_if<IsBitFields<FieldType>::value>::type> {
+  using Type = typename std::remove_cv<decltype(FieldType::bits)>::type;
+};
+
+// The number of bits a scalar field's value occupies: the packed width of a
+// BitFields member, 0 for the other scalars, which fill their storage.
+template <typename FieldType, typename = void>
+struct FieldPackedBits {
+  static constexpr std::size_t kValue = 0;
+};
+
+template <typename FieldType>
+struct FieldPackedBits<
+    FieldType, typename std::enable_if<IsBitFields<FieldType>::value>::type> {
+  static constexpr std::size_t kValue =
+      FieldType::get_offset(FieldType::kFieldCount);
+};
+
+// Fields that are converted as a single value, as opposed to class and
+// std::array members whose own fields are converted.
+template <typename FieldType>
+struct IsScalarField {
+  static constexpr bool kValue = std::is_arithmetic<FieldType>::value ||
+                                 std::is_enum<FieldType>::value ||
+                                 IsBitFields<FieldType>::value;
+};
+
+template <typename FieldType>
+struct FieldValueKind {
+  using ScalarType = typename FieldScalar<FieldType>::Type;
+  static constexpr ValueKind kValue =
+      std::is_floating_point<ScalarType>::value ? ValueKind::kFloatingPoint
+      : std::is_signed<ScalarType>::value       ? ValueKind::kSigned
+                                                : ValueKind::kUnsigned;
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_FIELD_LAYOUT_H
@@ -0,0 +1,162 @@
+// ABOUT: A fixed-capacity, lock-free single-producer/single-consumer ring of
+//        frames laid out in a (typically foreign) data model. The producer,
+//        e.g. an interrupt handler, only copies raw bytes into a slot; the
+//        consumer converts a frame to the native layout, or reads it in place
+//        through a SerializedView. All conversion cost is on the consumer.
+//
+//        A slot is the frame's serialized size, a compile-time constant, and
+//        slots are aligned to the frame's struct alignment in its data model,
+//        so a frame in a slot sits exactly as it would in the device's
+//        memory. The capacity is a power of two: positions increase forever
+//        and are masked into slot indexes.
+//
+//        Each side publishes its position with a release store and reads the
+//        other's with an acquire load. Each side also caches the other's last
+//        known position and only reloads it when the ring looks full (or
+//        empty), so a push or pop usually touches no cache line the other
+//        side writes.
+
+#ifndef LITTLE_PP_IMPL_FRAME_RING_H
+#define LITTLE_PP_IMPL_FRAME_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "layout.h"
+#include "native_layout.h"
+#include "padding_reflection.h"
+#include "serialization.h"
+#include "serialized_view.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// Keeps the producer's and the consumer's fields on separate cache lines.
+constexpr std::size_t kFrameRingCacheLineSize = 64;
+
+template <typename SerializableClassType, typename FrameDataModelType,
+          std::size_t kCapacity, typename NativeDataModelType>
+class FrameRing {
+ public:
+  using FrameLayout = Layout<SerializableClassType, FrameDataModelType>;
+  using View = SerializedView<SerializableClassType, FrameDataModelType>;
+  static constexpr std::size_t kSlotSize = FrameLayout::kSize;
+  static constexpr std::size_t kSlotAlignment =
+      SerializableClassAlignment<SerializableClassType,
+                                 FrameDataModelType>::kValue;
+
+  FrameRing() {
+    static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                  "The capacity must be a power of two.");
+    static_assert(kSlotSize % kSlotAlignment == 0,
+                  "Slots must be a multiple of their alignment.");
+  }
+
+  FrameRing(const FrameRing&) = delete;
+  auto operator=(const FrameRing&) -> FrameRing& = delete;
+
+  static constexpr auto get_capacity() -> std::size_t { return kCapacity; }
+
+  // Producer side. Copies kSlotSize bytes of `frame` into the ring; returns
+  // false (dropping the frame) when the ring is full.
+  auto try_push(const unsigned char* frame) -> bool {
+    unsigned char* slot = get_write_slot();
+    if (slot == nullptr) {
+      return false;
+    }
+    std::memcpy(slot, frame, kSlotSize);
+    commit_write();
+    return true;
+  }
+
+  // Producer side, for filling a slot in place (e.g. straight from a
+  // peripheral's FIFO): the next free slot, or nullptr when the ring is full.
+  // The frame becomes visible to the consumer on commit_write().
+  auto get_write_slot() -> unsigned char* {
+    const std::size_t tail = producer_.tail.load(std::memory_order_relaxed);
+    if (tail - producer_.cached_head == kCapacity) {
+      producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+      if (tail - producer_.cached_head == kCapacity) {
+        return nullptr;
+      }
+    }
+    return slots_[tail & (kCapacity - 1)].bytes;
+  }
+
+  void commit_write() {
+    producer_.tail.store(producer_.tail.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_release);
+  }
+
+  // Consumer side. Converts the oldest frame into `object` and frees its
+  // slot; returns false when the ring is empty.
+  auto try_pop(SerializableClassType& object) -> bool {
+    static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                  "Deserialized class type must be trivially copyable.");
+    static_assert(
+        NativeLayoutMatches<SerializableClassType,
+                            NativeDataModelType>::kValue,
+        "NativeDataModelType does not describe this architecture's layout of "
+        "the class.");
+    return try_consume([&object](const View& view) {
+      CopyPlan<SerializableClassType, FrameDataModelType,
+               NativeDataModelType>::apply(view.get_data(),
+                                           reinterpret_cast<unsigned char*>(
+                                               &object));
+    });
+  }
+
+  // Consumer side. Calls `visit(View)` on the oldest frame, in place, then
+  // frees its slot; returns false when the ring is empty. The view must not
+  // be used after `visit` returns.
+  template <typename Visitor>
+  auto try_consume(Visitor&& visit) -> bool {
+    const std::size_t head = consumer_.head.load(std::memory_order_relaxed);
+    if (head == consumer_.cached_tail) {
+      consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+      if (head == consumer_.cached_tail) {
+        return false;
+      }
+    }
+    visit(View(slots_[head & (kCapacity - 1)].bytes));
+    consumer_.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Frames pushed and not yet consumed; exact only on a quiescent ring.
+  auto size() const -> std::size_t {
+    // head first: the tail read after it can only be further ahead
+    const std::size_t head = consumer_.head.load(std::memory_order_acquire);
+    return producer_.tail.load(std::memory_order_acquire) - head;
+  }
+
+  auto is_empty() const -> bool { return size() == 0; }
+
+ private:
+  struct alignas(kSlotAlignment) Slot {
+    unsigned char bytes[(kSlotSize > 0) ? kSlotSize : 1];
+  };
+
+  struct alignas(kFrameRingCacheLineSize) ProducerState {
+    std::atomic<std::size_t> tail{0};
+    std::size_t cached_head = 0;
+  };
+
+  struct alignas(kFrameRingCacheLineSize) ConsumerState {
+    std::atomic<std::size_t> head{0};
+    std::size_t cached_tail = 0;
+  };
+
+  ProducerState producer_;
+  ConsumerState consumer_;
+  Slot slots_[kCapacity];
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_FRAME_RING_H
@@ -0,0 +1,181 @@
+// ABOUT: Gather (writev) serialization. Instead of copying the whole class into
+//        an output buffer, the CopyPlan's runs become an iovec list:
+//          - kCopy runs (fields already in the destination layout) reference
+//            the source object directly;
+//          - kConvert and kZero runs are written into a scratch area owned by
+//            the serializer, which holds only the converted fields and the
+//            padding.
+//        Scratch runs are laid out in destination order, so neighbouring
+//        scratch runs share one iovec. A copy run shorter than
+//        kMinReferencedSize also goes to the scratch area: copying a few bytes
+//        is cheaper than an extra iovec for the kernel to walk.
+//
+//        The iovec list, its length and the scratch size are all computed at
+//        compile time from the plan; filling the list only converts the
+//        scratch runs and stores the pointers.
+
+#ifndef LITTLE_PP_IMPL_GATHER_H
+#define LITTLE_PP_IMPL_GATHER_H
+
+#include <sys/uio.h>
+
+#include <climits>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "field_layout.h"
+#include "native_layout.h"
+#include "serialization.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// Below this many bytes a copy run is cheaper to copy than to reference.
+constexpr std::size_t kDefaultMinReferencedSize = 32;
+
+// `offset` is into the source object when the segment is referenced, into the
+// scratch area otherwise.
+struct GatherSegment {
+  bool is_referenced;
+  std::size_t offset;
+  std::size_t size;
+};
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType,
+          std::size_t kMinReferencedSize = kDefaultMinReferencedSize>
+class GatherSerializer {
+ public:
+  using Plan =
+      CopyPlan<SerializableClassType, SrcDataModelType, DstDataModelType>;
+  static constexpr std::size_t kSerializedSize = Plan::DstLayout::kSize;
+
+  static constexpr auto is_referenced(const CopyRun& run) -> bool {
+    return run.kind == RunKind::kCopy && run.dst_size >= kMinReferencedSize;
+  }
+
+  struct Segments {
+    ConstexprArray<GatherSegment, Plan::kRunCount> segments;
+    std::size_t count;
+    // where each scratch run is written; unused for referenced runs
+    ConstexprArray<std::size_t, Plan::kRunCount> run_scratch_offsets;
+    std::size_t scratch_size;
+  };
+
+  static constexpr auto make_segments() -> Segments {
+    Segments result{};
+    for (std::size_t i = 0; i < Plan::kRunCount; ++i) {
+      const CopyRun run = Plan::kRuns[i];
+      if (is_referenced(run)) {
+        result.segments[result.count] =
+            GatherSegment{true, run.src_offset, run.dst_size};
+        result.count++;
+        continue;
+      }
+      result.run_scratch_offsets[i] = result.scratch_size;
+      const bool extends_scratch =
+          result.count > 0 && !result.segments[result.count - 1].is_referenced;
+      if (extends_scratch) {
+        result.segments[result.count - 1].size += run.dst_size;
+      } else {
+        result.segments[result.count] =
+            GatherSegment{false, result.scratch_size, run.dst_size};
+        result.count++;
+      }
+      result.scratch_size += run.dst_size;
+    }
+    return result;
+  }
+
+  static constexpr Segments kSegments = make_segments();
+  static constexpr std::size_t kIovecCount = kSegments.count;
+  static constexpr std::size_t kScratchSize = kSegments.scratch_size;
+
+  // `object` must outlive the serializer (or the next reset()) and must not
+  // change while the iovecs are in use.
+  explicit GatherSerializer(const SerializableClassType& object) {
+    static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                  "Serialized class type must be trivially copyable.");
+    static_assert(
+        NativeLayoutMatches<SerializableClassType, SrcDataModelType>::kValue,
+        "SrcDataModelType does not describe this architecture's layout of "
+        "the class.");
+#ifdef IOV_MAX
+    // writev and sendmsg reject longer lists
+    static_assert(kIovecCount <= IOV_MAX,
+                  "The plan needs more iovecs than writev accepts; raise "
+                  "kMinReferencedSize.");
+#endif  // IOV_MAX
+    reset(object);
+  }
+
+  // The iovecs point into this object.
+  GatherSerializer(const GatherSerializer&) = delete;
+  auto operator=(const GatherSerializer&) -> GatherSerializer& = delete;
+
+  // Converts the scratch runs of `object` and points the iovecs at it.
+  void reset(const SerializableClassType& object) {
+    const auto* src = reinterpret_cast<const unsigned char*>(&object);
+    write_scratch_runs(src, std::make_index_sequence<Plan::kRunCount>{});
+    for (std::size_t i = 0; i < kIovecCount; ++i) {
+      const GatherSegment& segment = kSegments.segments[i];
+      // writev and sendmsg never write through iov_base
+      iovecs_[i].iov_base = segment.is_referenced
+                                ? const_cast<unsigned char*>(src) +
+                                      segment.offset
+                                : scratch_ + segment.offset;
+      iovecs_[i].iov_len = segment.size;
+    }
+  }
+
+  auto get_iovecs() -> iovec* { return iovecs_; }
+  auto get_iovecs() const -> const iovec* { return iovecs_; }
+  static constexpr auto get_iovec_count() -> std::size_t {
+    return kIovecCount;
+  }
+
+ private:
+  template <std::size_t I>
+  static void write_scratch_run(const unsigned char* /*unused*/,
+                                unsigned char* /*unused*/,
+                                std::true_type /*is_referenced*/) {}
+
+  template <std::size_t I>
+  static void write_scratch_run(const unsigned char* src,
+                                unsigned char* scratch,
+                                std::false_type /*is_referenced*/) {
+    Plan::template write_run<I>(
+        src, scratch + kSegments.run_scratch_offsets[I]);
+  }
+
+  template <std::size_t... I>
+  void write_scratch_runs(const unsigned char* src,
+                          std::index_sequence<I...> /*unused*/) {
+    using Expander = int[];
+    (void)Expander{
+        0, (write_scratch_run<I>(
+                src, scratch_,
+                std::integral_constant<bool, is_referenced(Plan::kRuns[I])>{}),
+            0)...};
+  }
+
+  // A zero-length array is ill-formed; keep one unused element instead.
+  iovec iovecs_[(kIovecCount > 0) ? kIovecCount : 1] = {};
+  unsigned char scratch_[(kScratchSize > 0) ? kScratchSize : 1] = {};
+};
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType, std::size_t kMinReferencedSize>
+constexpr typename GatherSerializer<SerializableClassType, SrcDataModelType,
+                                    DstDataModelType,
+                                    kMinReferencedSize>::Segments
+    GatherSerializer<SerializableClassType, SrcDataModelType,
+                     DstDataModelType, kMinReferencedSize>::kSegments;
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_GATHER_H
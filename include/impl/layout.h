@@ -0,0 +1,303 @@
+// ABOUT: The layout of a serializable class under a data model, computed in a
+//        single constexpr traversal of its fields: every field's offset, size
+//        and alignment, the runs of padding between (and after) them, and the
+//        class's size and alignment. The fields' types are expanded once
+//        through an index_sequence; everything else is an ordinary C++14
+//        constexpr loop, so neither the instantiation depth nor the number of
+//        instantiations grows with the field count.
+//
+//        Class and std::array members are laid out recursively under the same
+//        data model (their alignment and trailing padding included) and then
+//        flattened: a Layout also lists the scalar leaves of the class, i.e.
+//        every arithmetic, enum or BitFields value at its offset in the
+//        outermost class.
+//        Padding runs and copy plans are derived from the leaves, so nesting
+//        costs nothing at runtime.
+//
+//        Every other compile-time fact LittlePP exposes (padding reflection,
+//        copy plans, views) is a projection of a Layout.
+
+#ifndef LITTLE_PP_IMPL_LAYOUT_H
+#define LITTLE_PP_IMPL_LAYOUT_H
+
+#include <array>
+#include <boost/pfr/core.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../data_model.h"
+#include "byte_order.h"
+#include "field_layout.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// For class and std::array fields, value_kind is meaningless.
+struct FieldLayout {
+  std::size_t offset;
+  std::size_t size;
+  std::size_t alignment;
+  ValueKind value_kind;
+};
+
+struct PaddingRun {
+  std::size_t offset;
+  std::size_t size;
+};
+
+template <typename T>
+struct IsStdArray : std::false_type {};
+
+template <typename ElementType, std::size_t N>
+struct IsStdArray<std::array<ElementType, N>> : std::true_type {};
+
+// Class members whose own fields are laid out (and converted) individually.
+template <typename T>
+struct IsNestedClass {
+  static constexpr bool kValue = std::is_class<T>::value &&
+                                 !IsStdArray<T>::value &&
+                                 !IsScalarField<T>::kValue;
+};
+
+template <typename SerializableClassType, typename DataModelType>
+struct Layout;
+
+// The size, alignment and scalar leaves (offsets relative to the member) of a
+// member type. Leaves are returned by value: they are only needed while a
+// Layout is being computed.
+template <typename MemberType, typename DataModelType, typename = void>
+struct MemberLayout {
+  static_assert(IsSerializableType<MemberType>::kValue,
+                "Field type not supported.");
+};
+
+template <typename MemberType, typename DataModelType>
+struct MemberLayout<
+    MemberType, DataModelType,
+    typename std::enable_if<IsScalarField<MemberType>::kValue>::type> {
+  using ScalarType = typename FieldScalar<MemberType>::Type;
+  static constexpr std::size_t kSize =
+      DataModelType::template get_size<ScalarType>();
+  static constexpr std::size_t kAlignment =
+      DataModelType::template get_alignment<ScalarType>();
+  static constexpr std::size_t kLeafCount = 1;
+
+  static_assert(FieldPackedBits<MemberType>::kValue <= kSize * kBitsPerByte,
+                "BitFields widths exceed the storage type's size in the data "
+                "model.");
+
+  static constexpr auto make_leaves()
+      -> ConstexprArray<FieldLayout, kLeafCount> {
+    return ConstexprArray<FieldLayout, kLeafCount>{{FieldLayout{
+        0, kSize, kAlignment, FieldValueKind<MemberType>::kValue}}};
+  }
+};
+
+template <typename MemberType, typename DataModelType>
+struct MemberLayout<
+    MemberType, DataModelType,
+    typename std::enable_if<IsNestedClass<MemberType>::kValue>::type> {
+  using ClassLayout = Layout<MemberType, DataModelType>;
+  static constexpr std::size_t kSize = ClassLayout::kSize;
+  static constexpr std::size_t kAlignment = ClassLayout::kAlignment;
+  static constexpr std::size_t kLeafCount = ClassLayout::kLeafCount;
+
+  static constexpr auto make_leaves()
+      -> ConstexprArray<FieldLayout, kLeafCount> {
+    return ClassLayout::kDescriptor.leaves;
+  }
+};
+
+// Elements are strided by their size, which includes their trailing padding.
+template <typename ElementType, std::size_t N, typename DataModelType>
+struct MemberLayout<std::array<ElementType, N>, DataModelType, void> {
+  using ElementLayout = MemberLayout<ElementType, DataModelType>;
+  static constexpr std::size_t kSize = N * ElementLayout::kSize;
+  static constexpr std::size_t kAlignment = ElementLayout::kAlignment;
+  static constexpr std::size_t kLeafCount = N * ElementLayout::kLeafCount;
+
+  static constexpr auto make_leaves()
+      -> ConstexprArray<FieldLayout, kLeafCount> {
+    ConstexprArray<FieldLayout, kLeafCount> leaves{};
+    const ConstexprArray<FieldLayout, ElementLayout::kLeafCount>
+        element_leaves = ElementLayout::make_leaves();
+    for (std::size_t i = 0; i < N; ++i) {
+      for (std::size_t j = 0; j < ElementLayout::kLeafCount; ++j) {
+        FieldLayout leaf = element_leaves[j];
+        leaf.offset += i * ElementLayout::kSize;
+        leaves[i * ElementLayout::kLeafCount + j] = leaf;
+      }
+    }
+    return leaves;
+  }
+};
+
+template <typename SerializableClassType, typename DataModelType>
+struct Layout {
+  static constexpr std::size_t kFieldCount =
+      boost::pfr::tuple_size_v<SerializableClassType>;
+
+  template <std::size_t I>
+  using FieldType = boost::pfr::tuple_element_t<I, SerializableClassType>;
+  template <std::size_t I>
+  using FieldMemberLayout = MemberLayout<FieldType<I>, DataModelType>;
+
+  template <std::size_t... I>
+  static constexpr auto count_leaves(std::index_sequence<I...> /*unused*/)
+      -> std::size_t {
+    std::size_t count = 0;
+    using Expander = std::size_t[];
+    (void)Expander{0, (count += FieldMemberLayout<I>::kLeafCount)...};
+    return count;
+  }
+
+  static constexpr std::size_t kLeafCount =
+      count_leaves(std::make_index_sequence<kFieldCount>{});
+  // padding before every leaf, plus trailing padding
+  static constexpr std::size_t kMaxPaddingRunCount = kLeafCount + 1;
+
+  using FieldArray = ConstexprArray<FieldLayout, kFieldCount>;
+  using LeafArray = ConstexprArray<FieldLayout, kLeafCount>;
+
+  struct Descriptor {
+    FieldArray fields;
+    LeafArray leaves;
+    ConstexprArray<PaddingRun, kMaxPaddingRunCount> padding_runs;
+    std::size_t padding_run_count;
+    std::size_t padding_byte_count;
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  // The offset is filled in by make_descriptor.
+  template <std::size_t I>
+  static constexpr auto make_field() -> FieldLayout {
+    return FieldLayout{0, FieldMemberLayout<I>::kSize,
+                       FieldMemberLayout<I>::kAlignment,
+                       FieldValueKind<FieldType<I>>::kValue};
+  }
+
+  template <std::size_t... I>
+  static constexpr auto make_fields(std::index_sequence<I...> /*unused*/)
+      -> FieldArray {
+    return FieldArray{{make_field<I>()...}};
+  }
+
+  // Appends field I's leaves, rebased onto the field's offset.
+  template <std::size_t I>
+  static constexpr auto append_leaves(Descriptor& descriptor,
+                                      std::size_t first_leaf) -> std::size_t {
+    const ConstexprArray<FieldLayout, FieldMemberLayout<I>::kLeafCount>
+        member_leaves = FieldMemberLayout<I>::make_leaves();
+    for (std::size_t j = 0; j < FieldMemberLayout<I>::kLeafCount; ++j) {
+      FieldLayout leaf = member_leaves[j];
+      leaf.offset += descriptor.fields[I].offset;
+      descriptor.leaves[first_leaf + j] = leaf;
+    }
+    return first_leaf + FieldMemberLayout<I>::kLeafCount;
+  }
+
+  template <std::size_t... I>
+  static constexpr void flatten(Descriptor& descriptor,
+                                std::index_sequence<I...> /*unused*/) {
+    std::size_t next_leaf = 0;
+    using Expander = std::size_t[];
+    (void)Expander{0, (next_leaf = append_leaves<I>(descriptor, next_leaf))...};
+    (void)next_leaf;  // unused when the class has no fields
+  }
+
+  static constexpr void append_padding_run(Descriptor& descriptor,
+                                           std::size_t offset,
+                                           std::size_t size) {
+    descriptor.padding_runs[descriptor.padding_run_count] =
+        PaddingRun{offset, size};
+    descriptor.padding_run_count++;
+    descriptor.padding_byte_count += size;
+  }
+
+  static constexpr auto make_descriptor() -> Descriptor {
+    Descriptor descriptor{make_fields(std::make_index_sequence<kFieldCount>{}),
+                          {},
+                          {},
+                          0,
+                          0,
+                          0,
+                          0};
+    std::size_t filled = 0;
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      FieldLayout& field = descriptor.fields[i];
+      field.offset = align_up(filled, field.alignment);
+      filled = field.offset + field.size;
+      if (field.alignment > descriptor.alignment) {
+        descriptor.alignment = field.alignment;
+      }
+    }
+    descriptor.size = align_up(filled, descriptor.alignment);
+
+    // Padding is every byte not covered by a leaf, which includes the
+    // alignment and trailing padding of nested members.
+    flatten(descriptor, std::make_index_sequence<kFieldCount>{});
+    filled = 0;
+    for (std::size_t i = 0; i < kLeafCount; ++i) {
+      const FieldLayout& leaf = descriptor.leaves[i];
+      if (leaf.offset > filled) {
+        append_padding_run(descriptor, filled, leaf.offset - filled);
+      }
+      filled = leaf.offset + leaf.size;
+    }
+    // account for trailing padding
+    if (descriptor.size > filled) {
+      append_padding_run(descriptor, filled, descriptor.size - filled);
+    }
+    return descriptor;
+  }
+
+  static constexpr Descriptor kDescriptor = make_descriptor();
+
+  // The class's direct members.
+  static constexpr FieldArray kFields = kDescriptor.fields;
+  // Every scalar in the class, nested ones included, ordered by offset.
+  static constexpr LeafArray kLeaves = kDescriptor.leaves;
+  static constexpr std::size_t kPaddingRunCount = kDescriptor.padding_run_count;
+  static constexpr std::size_t kPaddingByteCount =
+      kDescriptor.padding_byte_count;
+  // includes trailing padding
+  static constexpr std::size_t kSize = kDescriptor.size;
+  // 0 for a class without fields
+  static constexpr std::size_t kAlignment = kDescriptor.alignment;
+
+  using PaddingRunArray = ConstexprArray<PaddingRun, kPaddingRunCount>;
+
+  template <std::size_t... I>
+  static constexpr auto make_padding_runs(std::index_sequence<I...> /*unused*/)
+      -> PaddingRunArray {
+    return PaddingRunArray{{kDescriptor.padding_runs[I]...}};
+  }
+
+  // Ordered by offset.
+  static constexpr PaddingRunArray kPaddingRuns =
+      make_padding_runs(std::make_index_sequence<kPaddingRunCount>{});
+};
+
+// Out-of-class definitions; these tables are indexed at runtime.
+template <typename SerializableClassType, typename DataModelType>
+constexpr typename Layout<SerializableClassType, DataModelType>::Descriptor
+    Layout<SerializableClassType, DataModelType>::kDescriptor;
+template <typename SerializableClassType, typename DataModelType>
+constexpr typename Layout<SerializableClassType, DataModelType>::FieldArray
+    Layout<SerializableClassType, DataModelType>::kFields;
+template <typename SerializableClassType, typename DataModelType>
+constexpr typename Layout<SerializableClassType, DataModelType>::LeafArray
+    Layout<SerializableClassType, DataModelType>::kLeaves;
+template <typename SerializableClassType, typename DataModelType>
+constexpr
+    typename Layout<SerializableClassType, DataModelType>::PaddingRunArray
+        Layout<SerializableClassType, DataModelType>::kPaddingRuns;
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_LAYOUT_H
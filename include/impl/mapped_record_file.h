@@ -0,0 +1,222 @@
+// ABOUT: Read-only access to a file that is a flat array of records laid out in
+//        a (typically foreign) data model, e.g. a flash log dumped by a
+//        device. The file is mmap'd rather than read: records are only
+//        converted when they are accessed, and only the pages that are
+//        touched are read, through the kernel's page cache.
+//
+//        Records are strided by the class's serialized size under the file's
+//        data model, a compile-time constant, so locating record i is a
+//        multiplication. Converting a record is the same CopyPlan deserialize
+//        uses; converting a range of records is convert_n.
+
+#ifndef LITTLE_PP_IMPL_MAPPED_RECORD_FILE_H
+#define LITTLE_PP_IMPL_MAPPED_RECORD_FILE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "batch_conversion.h"
+#include "layout.h"
+#include "native_layout.h"
+#include "serialization.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// Closes a file descriptor on scope exit.
+class FileDescriptorCloser {
+ public:
+  explicit FileDescriptorCloser(int fd) : fd_(fd) {}
+  FileDescriptorCloser(const FileDescriptorCloser&) = delete;
+  auto operator=(const FileDescriptorCloser&)
+      -> FileDescriptorCloser& = delete;
+  ~FileDescriptorCloser() { ::close(fd_); }
+
+ private:
+  int fd_;
+};
+
+template <typename SerializableClassType, typename FileDataModelType,
+          typename NativeDataModelType>
+class MappedRecordFile {
+ public:
+  static constexpr std::size_t kRecordSize =
+      Layout<SerializableClassType, FileDataModelType>::kSize;
+
+  // Converts records lazily: dereferencing converts the current record.
+  // Dereferencing returns a value, not a reference, so this is only an input
+  // iterator.
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = SerializableClassType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    // records are converted on access, so there is nothing to refer to
+    using reference = SerializableClassType;
+
+    Iterator() = default;
+
+    auto operator*() const -> SerializableClassType {
+      return file_->get(index_);
+    }
+    auto operator++() -> Iterator& {
+      index_++;
+      return *this;
+    }
+    auto operator++(int) -> Iterator {
+      Iterator previous = *this;
+      index_++;
+      return previous;
+    }
+    auto operator==(const Iterator& other) const -> bool {
+      return file_ == other.file_ && index_ == other.index_;
+    }
+    auto operator!=(const Iterator& other) const -> bool {
+      return !(*this == other);
+    }
+
+   private:
+    friend class MappedRecordFile;
+    Iterator(const MappedRecordFile* file, std::size_t index)
+        : file_(file), index_(index) {}
+
+    const MappedRecordFile* file_ = nullptr;
+    std::size_t index_ = 0;
+  };
+
+  // Maps the file at `path`. Throws std::system_error if it cannot be opened
+  // or mapped.
+  explicit MappedRecordFile(const std::string& path) {
+    static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                  "Deserialized class type must be trivially copyable.");
+    static_assert(kRecordSize > 0, "Records must not be empty.");
+    static_assert(
+        NativeLayoutMatches<SerializableClassType,
+                            NativeDataModelType>::kValue,
+        "NativeDataModelType does not describe this architecture's layout of "
+        "the class.");
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "open " + path);
+    }
+    const FileDescriptorCloser closer(fd);
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "fstat " + path);
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    // mmap rejects empty mappings; an empty file simply has no records
+    if (size_ == 0) {
+      return;
+    }
+    // the mapping stays valid after the descriptor is closed
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(),
+                              "mmap " + path);
+    }
+    data_ = static_cast<const unsigned char*>(mapping);
+  }
+
+  MappedRecordFile(const MappedRecordFile&) = delete;
+  auto operator=(const MappedRecordFile&) -> MappedRecordFile& = delete;
+
+  MappedRecordFile(MappedRecordFile&& other) noexcept
+      : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  auto operator=(MappedRecordFile&& other) noexcept -> MappedRecordFile& {
+    if (this != &other) {
+      unmap();
+      data_ = other.data_;
+      size_ = other.size_;
+      other.data_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  ~MappedRecordFile() { unmap(); }
+
+  // A trailing partial record (e.g. a log cut off mid-write) is not counted.
+  auto size() const -> std::size_t { return size_ / kRecordSize; }
+  auto empty() const -> bool { return size() == 0; }
+  auto get_trailing_byte_count() const -> std::size_t {
+    return size_ % kRecordSize;
+  }
+
+  // The unconverted bytes of record `index`.
+  auto get_record_bytes(std::size_t index) const -> const unsigned char* {
+    return data_ + index * kRecordSize;
+  }
+
+  // Converts record `index`, which must be less than size().
+  auto get(std::size_t index) const -> SerializableClassType {
+    SerializableClassType record;
+    CopyPlan<SerializableClassType, FileDataModelType,
+             NativeDataModelType>::apply(get_record_bytes(index),
+                                         reinterpret_cast<unsigned char*>(
+                                             &record));
+    return record;
+  }
+
+  auto operator[](std::size_t index) const -> SerializableClassType {
+    return get(index);
+  }
+
+  // Like get(), but throws std::out_of_range past the last record.
+  auto at(std::size_t index) const -> SerializableClassType {
+    if (index >= size()) {
+      throw std::out_of_range("MappedRecordFile record index out of range");
+    }
+    return get(index);
+  }
+
+  // Converts records [first, first + count) into `records`. The range must be
+  // within size().
+  void decode(std::size_t first, std::size_t count,
+              SerializableClassType* records) const {
+    BatchConversion<SerializableClassType, FileDataModelType,
+                    NativeDataModelType>::
+        convert(get_record_bytes(first),
+                reinterpret_cast<unsigned char*>(records), count);
+  }
+
+  auto begin() const -> Iterator { return Iterator(this, 0); }
+  auto end() const -> Iterator { return Iterator(this, size()); }
+
+ private:
+  void unmap() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<unsigned char*>(data_), size_);
+      data_ = nullptr;
+    }
+  }
+
+  const unsigned char* data_ = nullptr;
+  // in bytes, including a trailing partial record
+  std::size_t size_ = 0;
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_MAPPED_RECORD_FILE_H
@@ -0,0 +1,156 @@
+// ABOUT: Checks that a data model describes how the compiler actually lays out
+//        a class. The layout LittlePP computes is only an assumption about the
+//        compiler's ABI; #pragma pack, -malign-double or an alignas member
+//        silently break it. Serializing straight from (or deserializing
+//        straight into) an object is only safe when the two agree.
+//
+//        Sizes and alignments are compared at compile time, for the class and
+//        recursively for its class members, which catches repacking and
+//        realignment. Offsets themselves can only be compared at runtime
+//        (address arithmetic on the fields pfr returns is not a constant
+//        expression), so has_native_field_offsets compares the address of
+//        every field against its computed offset.
+
+#ifndef LITTLE_PP_IMPL_NATIVE_LAYOUT_H
+#define LITTLE_PP_IMPL_NATIVE_LAYOUT_H
+
+#include <array>
+#include <boost/pfr/core.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "field_layout.h"
+#include "layout.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+template <typename SerializableClassType, typename DataModelType>
+struct NativeLayoutMatches;
+
+template <typename MemberType, typename DataModelType, typename = void>
+struct NativeMemberLayoutMatches {
+  using Expected = MemberLayout<MemberType, DataModelType>;
+  static constexpr bool kValue = sizeof(MemberType) == Expected::kSize &&
+                                 alignof(MemberType) == Expected::kAlignment;
+};
+
+template <typename MemberType, typename DataModelType>
+struct NativeMemberLayoutMatches<
+    MemberType, DataModelType,
+    typename std::enable_if<IsNestedClass<MemberType>::kValue>::type> {
+  static constexpr bool kValue =
+      NativeLayoutMatches<MemberType, DataModelType>::kValue;
+};
+
+template <typename ElementType, std::size_t N, typename DataModelType>
+struct NativeMemberLayoutMatches<std::array<ElementType, N>, DataModelType,
+                                 void> {
+  using Expected = MemberLayout<std::array<ElementType, N>, DataModelType>;
+  static constexpr bool kValue =
+      NativeMemberLayoutMatches<ElementType, DataModelType>::kValue &&
+      sizeof(std::array<ElementType, N>) == Expected::kSize;
+};
+
+template <typename SerializableClassType, typename DataModelType>
+struct NativeLayoutMatches {
+  using LayoutType = Layout<SerializableClassType, DataModelType>;
+
+  template <std::size_t... I>
+  static constexpr auto members_match(std::index_sequence<I...> /*unused*/)
+      -> bool {
+    const ConstexprArray<bool, LayoutType::kFieldCount> matches{
+        {NativeMemberLayoutMatches<typename LayoutType::template FieldType<I>,
+                                   DataModelType>::kValue...}};
+    for (std::size_t i = 0; i < LayoutType::kFieldCount; ++i) {
+      if (!matches[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // A class without fields still occupies a byte; it has nothing to compare.
+  static constexpr bool kValue =
+      LayoutType::kFieldCount == 0 ||
+      (sizeof(SerializableClassType) == LayoutType::kSize &&
+       alignof(SerializableClassType) == LayoutType::kAlignment &&
+       members_match(std::make_index_sequence<LayoutType::kFieldCount>{}));
+};
+
+// Compares the address of every field, nested ones included, with its offset
+// under DataModelType. The overloads are static members so that each one can
+// recurse into the others regardless of declaration order.
+template <typename DataModelType>
+struct NativeOffsets {
+  // Whether `member`, and everything nested in it, sits at `expected_offset`
+  // bytes from `base`.
+  template <typename MemberType>
+  static auto match(const MemberType& member, const unsigned char* base,
+                    std::size_t expected_offset) ->
+      typename std::enable_if<IsScalarField<MemberType>::kValue, bool>::type {
+    return is_at(member, base, expected_offset);
+  }
+
+  template <typename ElementType, std::size_t N>
+  static auto match(const std::array<ElementType, N>& member,
+                    const unsigned char* base, std::size_t expected_offset)
+      -> bool {
+    for (std::size_t i = 0; i < N; ++i) {
+      if (!match(member[i], base,
+                 expected_offset +
+                     i * MemberLayout<ElementType, DataModelType>::kSize)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename MemberType>
+  static auto match(const MemberType& member, const unsigned char* base,
+                    std::size_t expected_offset) ->
+      typename std::enable_if<IsNestedClass<MemberType>::kValue, bool>::type {
+    return is_at(member, base, expected_offset) &&
+           match_fields(member, base, expected_offset,
+                        std::make_index_sequence<
+                            Layout<MemberType, DataModelType>::kFieldCount>{});
+  }
+
+  template <typename MemberType, std::size_t... I>
+  static auto match_fields(const MemberType& member, const unsigned char* base,
+                           std::size_t expected_offset,
+                           std::index_sequence<I...> /*unused*/) -> bool {
+    using LayoutType = Layout<MemberType, DataModelType>;
+    const bool matches[] = {
+        true, match(boost::pfr::get<I>(member), base,
+                    expected_offset + LayoutType::kFields[I].offset)...};
+    for (const bool is_match : matches) {
+      if (!is_match) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename MemberType>
+  static auto is_at(const MemberType& member, const unsigned char* base,
+                    std::size_t expected_offset) -> bool {
+    return reinterpret_cast<const unsigned char*>(&member) - base ==
+           static_cast<std::ptrdiff_t>(expected_offset);
+  }
+};
+
+template <typename SerializableClassType, typename DataModelType>
+auto has_native_field_offsets() -> bool {
+  const SerializableClassType object{};
+  return NativeOffsets<DataModelType>::match(
+      object, reinterpret_cast<const unsigned char*>(&object), 0);
+}
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_NATIVE_LAYOUT_H
@@ -0,0 +1,183 @@
+// ABOUT: How much of a class's layout is padding, and the order of its direct
+//        members that minimizes it. Reordering moves whole members, so the
+//        padding inside nested members stays; only the size of the class
+//        itself can shrink.
+//
+//        A class is never smaller than its members' sizes summed and rounded
+//        up to its alignment. Ordering members by decreasing alignment (ties
+//        keep declaration order) reaches that bound whenever every member's
+//        size is a multiple of its alignment, which holds for the usual data
+//        models, so this order is tried first. When it does not reach the
+//        bound, every permutation is searched for classes of up to
+//        kMaxExhaustiveFieldCount members; larger classes keep the sorted
+//        order, which is then not known to be optimal.
+
+#ifndef LITTLE_PP_IMPL_PADDING_ANALYSIS_H
+#define LITTLE_PP_IMPL_PADDING_ANALYSIS_H
+
+#include <array>
+#include <cstddef>
+
+#include "field_layout.h"
+#include "layout.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// 7! orders stay within GCC's default constexpr operation limit
+// (-fconstexpr-ops-limit); 8! exceed it.
+constexpr std::size_t kMaxExhaustiveFieldCount = 7;
+
+struct PaddingReport {
+  // includes trailing padding
+  std::size_t size;
+  std::size_t padding_byte_count;
+  // padding_byte_count / size; 0 for an empty class
+  double padding_ratio;
+  // the size and padding with the members in the optimal order
+  std::size_t optimal_size;
+  std::size_t optimal_padding_byte_count;
+  // false when the optimal order is only the best order found
+  bool is_optimal_order_exact;
+};
+
+template <typename SerializableClassType, typename DataModelType>
+struct PaddingAnalysis {
+  using LayoutType = Layout<SerializableClassType, DataModelType>;
+  static constexpr std::size_t kFieldCount = LayoutType::kFieldCount;
+  using Order = ConstexprArray<std::size_t, kFieldCount>;
+
+  // The class's size with its members laid out in `order`.
+  static constexpr auto get_size(const Order& order) -> std::size_t {
+    std::size_t filled = 0;
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      const FieldLayout& field = LayoutType::kFields[order[i]];
+      filled = align_up(filled, field.alignment) + field.size;
+    }
+    return align_up(filled, LayoutType::kAlignment);
+  }
+
+  static constexpr auto get_lower_bound_size() -> std::size_t {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      size += LayoutType::kFields[i].size;
+    }
+    return align_up(size, LayoutType::kAlignment);
+  }
+
+  // By decreasing alignment; an insertion sort keeps ties in declaration
+  // order.
+  static constexpr auto make_sorted_order() -> Order {
+    Order order{};
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      std::size_t j = i;
+      while (j > 0 && LayoutType::kFields[order[j - 1]].alignment <
+                          LayoutType::kFields[i].alignment) {
+        order[j] = order[j - 1];
+        j--;
+      }
+      order[j] = i;
+    }
+    return order;
+  }
+
+  // Advances `order` to the next permutation in lexicographic order; returns
+  // false after the last one.
+  static constexpr auto next_order(Order& order) -> bool {
+    if (kFieldCount < 2) {
+      return false;
+    }
+    std::size_t i = kFieldCount - 1;
+    while (i > 0 && order[i - 1] >= order[i]) {
+      i--;
+    }
+    if (i == 0) {
+      return false;
+    }
+    std::size_t j = kFieldCount - 1;
+    while (order[j] <= order[i - 1]) {
+      j--;
+    }
+    const std::size_t swapped = order[i - 1];
+    order[i - 1] = order[j];
+    order[j] = swapped;
+    for (std::size_t a = i, b = kFieldCount - 1; a < b; ++a, --b) {
+      const std::size_t reversed = order[a];
+      order[a] = order[b];
+      order[b] = reversed;
+    }
+    return true;
+  }
+
+  struct Result {
+    Order order;
+    std::size_t size;
+    bool is_exact;
+  };
+
+  static constexpr auto find_optimal_order() -> Result {
+    Result best{make_sorted_order(), 0, true};
+    best.size = get_size(best.order);
+    if (best.size == get_lower_bound_size()) {
+      return best;
+    }
+    if (kFieldCount > kMaxExhaustiveFieldCount) {
+      best.is_exact = false;
+      return best;
+    }
+    Order order{};
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      order[i] = i;
+    }
+    do {
+      const std::size_t size = get_size(order);
+      if (size < best.size) {
+        best.order = order;
+        best.size = size;
+      }
+    } while (next_order(order));
+    return best;
+  }
+
+  static constexpr Result kOptimal = find_optimal_order();
+
+  static constexpr auto make_report() -> PaddingReport {
+    // reordering keeps every data byte, so it only removes padding
+    return PaddingReport{
+        LayoutType::kSize,
+        LayoutType::kPaddingByteCount,
+        (LayoutType::kSize == 0)
+            ? 0.0
+            : static_cast<double>(LayoutType::kPaddingByteCount) /
+                  static_cast<double>(LayoutType::kSize),
+        kOptimal.size,
+        LayoutType::kPaddingByteCount - (LayoutType::kSize - kOptimal.size),
+        kOptimal.is_exact};
+  }
+
+  static constexpr PaddingReport kReport = make_report();
+
+  // Member indexes in declaration order, listed in the optimal order.
+  static constexpr std::array<std::size_t, kFieldCount> kOptimalOrder =
+      to_std_array(kOptimal.order);
+};
+
+template <typename SerializableClassType, typename DataModelType>
+constexpr typename PaddingAnalysis<SerializableClassType,
+                                   DataModelType>::Result
+    PaddingAnalysis<SerializableClassType, DataModelType>::kOptimal;
+template <typename SerializableClassType, typename DataModelType>
+constexpr PaddingReport
+    PaddingAnalysis<SerializableClassType, DataModelType>::kReport;
+template <typename SerializableClassType, typename DataModelType>
+constexpr std::array<
+    std::size_t,
+    PaddingAnalysis<SerializableClassType, DataModelType>::kFieldCount>
+    PaddingAnalysis<SerializableClassType, DataModelType>::kOptimalOrder;
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_PADDING_ANALYSIS_H
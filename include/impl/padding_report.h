@@ -0,0 +1,112 @@
+// ABOUT: JSON output of padding reports (see padding_analysis.h), one object
+//        per class with an entry per data model, for tools that track padding
+//        waste over time. Only the JSON escaping and field order live here;
+//        every value is computed at compile time.
+
+#ifndef LITTLE_PP_IMPL_PADDING_REPORT_H
+#define LITTLE_PP_IMPL_PADDING_REPORT_H
+
+#include <array>
+#include <boost/pfr/core.hpp>
+#include <cstddef>
+#include <ostream>
+
+#include "padding_analysis.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+inline void write_json_string(std::ostream& out, const char* text) {
+  constexpr char kHexDigits[] = "0123456789abcdef";
+  out << '"';
+  for (const char* c = text; *c != '\0'; ++c) {
+    const auto byte = static_cast<unsigned char>(*c);
+    if (*c == '"' || *c == '\\') {
+      out << '\\' << *c;
+    } else if (byte < 0x20) {
+      out << "\\u00" << kHexDigits[byte >> 4] << kHexDigits[byte & 0xF];
+    } else {
+      out << *c;
+    }
+  }
+  out << '"';
+}
+
+template <typename SerializableClassType, typename DataModelType>
+void write_padding_report_entry_json(std::ostream& out,
+                                     const char* data_model_name) {
+  using Analysis = PaddingAnalysis<SerializableClassType, DataModelType>;
+  constexpr PaddingReport kReport = Analysis::kReport;
+  out << "{\"name\":";
+  write_json_string(out, data_model_name);
+  out << ",\"size\":" << kReport.size
+      << ",\"padding_bytes\":" << kReport.padding_byte_count
+      << ",\"padding_ratio\":" << kReport.padding_ratio
+      << ",\"optimal_size\":" << kReport.optimal_size
+      << ",\"optimal_padding_bytes\":" << kReport.optimal_padding_byte_count
+      << ",\"optimal_field_order\":[";
+  for (std::size_t i = 0; i < Analysis::kFieldCount; ++i) {
+    out << ((i == 0) ? "" : ",") << Analysis::kOptimalOrder[i];
+  }
+  out << "],\"optimal_order_exact\":"
+      << (kReport.is_optimal_order_exact ? "true" : "false") << '}';
+}
+
+template <typename SerializableClassType, typename... DataModelTypes>
+void write_padding_report_json(
+    std::ostream& out, const char* class_name,
+    const std::array<const char*, sizeof...(DataModelTypes)>&
+        data_model_names) {
+  out << "{\"class\":";
+  write_json_string(out, class_name);
+  out << ",\"field_count\":"
+      << boost::pfr::tuple_size_v<SerializableClassType>
+      << ",\"data_models\":[";
+  std::size_t i = 0;
+  using Expander = int[];
+  (void)Expander{
+      0, ((out << ((i == 0) ? "" : ",")),
+          write_padding_report_entry_json<SerializableClassType,
+                                          DataModelTypes>(
+              out, data_model_names[i]),
+          i++, 0)...};
+  out << "]}";
+}
+
+// The data models a report covers, in the order of their names.
+template <typename... DataModelTypes>
+struct DataModelList {
+  static constexpr std::size_t kCount = sizeof...(DataModelTypes);
+};
+
+template <typename DataModelListType, typename... SerializableClassTypes>
+struct PaddingReportWriter;
+
+template <typename... DataModelTypes, typename... SerializableClassTypes>
+struct PaddingReportWriter<DataModelList<DataModelTypes...>,
+                           SerializableClassTypes...> {
+  static void write(
+      std::ostream& out,
+      const std::array<const char*, sizeof...(SerializableClassTypes)>&
+          class_names,
+      const std::array<const char*, sizeof...(DataModelTypes)>&
+          data_model_names) {
+    out << '[';
+    std::size_t i = 0;
+    using Expander = int[];
+    (void)Expander{
+        0, ((out << ((i == 0) ? "\n" : ",\n")),
+            write_padding_report_json<SerializableClassTypes,
+                                      DataModelTypes...>(
+                out, class_names[i], data_model_names),
+            i++, 0)...};
+    out << "\n]";
+  }
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_PADDING_REPORT_H
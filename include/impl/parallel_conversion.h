@@ -0,0 +1,123 @@
+// ABOUT: Splits a batch conversion across threads. Records have a
+//        compile-time size in both data models, so the buffers are cut into
+//        fixed chunks of records without looking at the data; each chunk is
+//        converted in place (at the same record index) by BatchConversion, so
+//        the output stays contiguous and in order regardless of which thread
+//        converted which chunk.
+//
+//        Chunks are handed out through a shared atomic cursor: a thread that
+//        finishes early simply claims the next unconverted chunk, which
+//        balances load the same way work stealing would for equal-cost,
+//        independent chunks, without per-thread queues.
+
+#ifndef LITTLE_PP_IMPL_PARALLEL_CONVERSION_H
+#define LITTLE_PP_IMPL_PARALLEL_CONVERSION_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "batch_conversion.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// Chunks default to roughly this many source bytes; small enough to balance
+// load, large enough that claiming a chunk is negligible.
+constexpr std::size_t kDefaultChunkBytes = std::size_t{256} * 1024;
+
+// Joins every thread on scope exit so an exception while spawning threads does
+// not destroy joinable threads.
+class ThreadJoiner {
+ public:
+  explicit ThreadJoiner(std::vector<std::thread>& threads)
+      : threads_(threads) {}
+  ThreadJoiner(const ThreadJoiner&) = delete;
+  auto operator=(const ThreadJoiner&) -> ThreadJoiner& = delete;
+  ~ThreadJoiner() {
+    for (std::thread& thread : threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+  }
+
+ private:
+  std::vector<std::thread>& threads_;
+};
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+struct ParallelConversion {
+  using Batch = BatchConversion<SerializableClassType, SrcDataModelType,
+                                DstDataModelType>;
+
+  static auto default_thread_count() -> std::size_t {
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    return (hardware == 0) ? 1 : hardware;
+  }
+
+  static auto default_chunk_record_count() -> std::size_t {
+    return (Batch::kSrcSize == 0 || Batch::kSrcSize >= kDefaultChunkBytes)
+               ? 1
+               : kDefaultChunkBytes / Batch::kSrcSize;
+  }
+
+  static void convert_chunks(const unsigned char* src, unsigned char* dst,
+                             std::size_t count, std::size_t chunk_record_count,
+                             std::atomic<std::size_t>& next_chunk) {
+    const std::size_t chunk_count =
+        (count + chunk_record_count - 1) / chunk_record_count;
+    for (std::size_t chunk = next_chunk.fetch_add(1); chunk < chunk_count;
+         chunk = next_chunk.fetch_add(1)) {
+      const std::size_t first = chunk * chunk_record_count;
+      const std::size_t last = (first + chunk_record_count < count)
+                                   ? first + chunk_record_count
+                                   : count;
+      Batch::convert(src + first * Batch::kSrcSize,
+                     dst + first * Batch::kDstSize, last - first);
+    }
+  }
+
+  static void convert(const unsigned char* src, unsigned char* dst,
+                      std::size_t count, std::size_t thread_count,
+                      std::size_t chunk_record_count) {
+    if (thread_count == 0) {
+      thread_count = default_thread_count();
+    }
+    if (chunk_record_count == 0) {
+      chunk_record_count = default_chunk_record_count();
+    }
+    const std::size_t chunk_count =
+        (count + chunk_record_count - 1) / chunk_record_count;
+    if (thread_count > chunk_count) {
+      thread_count = chunk_count;
+    }
+    if (thread_count <= 1) {
+      Batch::convert(src, dst, count);
+      return;
+    }
+
+    std::atomic<std::size_t> next_chunk{0};
+    std::vector<std::thread> workers;
+    workers.reserve(thread_count - 1);
+    {
+      const ThreadJoiner joiner(workers);
+      for (std::size_t i = 1; i < thread_count; ++i) {
+        workers.emplace_back(convert_chunks, src, dst, count,
+                             chunk_record_count, std::ref(next_chunk));
+      }
+      // the calling thread converts chunks too
+      convert_chunks(src, dst, count, chunk_record_count, next_chunk);
+    }
+  }
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_PARALLEL_CONVERSION_H
@@ -0,0 +1,389 @@
+// ABOUT: Data models that are only known at runtime, e.g. after a handshake
+//        with a device. A DataModelDescriptor holds the same values as a
+//        DataModel's template parameters. A class's layout under it is
+//        computed at runtime from the class's TypeSchema: a compile-time,
+//        pre-order list of the class's members (scalars by their data model
+//        type index, class and std::array members followed by their own
+//        members). The runtime traversal mirrors Layout's: members are
+//        aligned, nested members laid out recursively and flattened into
+//        leaves, and padding runs derived from the leaves.
+
+#ifndef LITTLE_PP_IMPL_RUNTIME_DATA_MODEL_H
+#define LITTLE_PP_IMPL_RUNTIME_DATA_MODEL_H
+
+#include <array>
+#include <boost/pfr/core.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../data_model.h"
+#include "field_layout.h"
+#include "layout.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// The number of types a DataModel describes (see DataModelTypeIndex).
+constexpr std::size_t kDataModelTypeCount = 16;
+
+// Runtime plans store offsets and sizes in 32 bits.
+constexpr std::size_t kMaxRuntimeLayoutSize = UINT32_MAX;
+
+// Sizes and alignments are indexed by DataModelTypeIndex, i.e. in the order
+// of DataModel's template parameters.
+struct DataModelDescriptor {
+  std::array<std::size_t, kDataModelTypeCount> sizes;
+  std::array<std::size_t, kDataModelTypeCount> alignments;
+  little_pp::Endianess endianess;
+};
+
+inline auto operator==(const DataModelDescriptor& a,
+                       const DataModelDescriptor& b) -> bool {
+  return a.sizes == b.sizes && a.alignments == b.alignments &&
+         a.endianess == b.endianess;
+}
+
+inline auto operator!=(const DataModelDescriptor& a,
+                       const DataModelDescriptor& b) -> bool {
+  return !(a == b);
+}
+
+// FNV-1a (32-bit constants) over every value.
+struct DataModelDescriptorHash {
+  auto operator()(const DataModelDescriptor& descriptor) const
+      -> std::size_t {
+    std::size_t hash = 2166136261U;
+    const auto mix = [&hash](std::size_t value) {
+      hash = (hash ^ value) * 16777619U;
+    };
+    for (std::size_t i = 0; i < kDataModelTypeCount; ++i) {
+      mix(descriptor.sizes[i]);
+      mix(descriptor.alignments[i]);
+    }
+    mix(static_cast<std::size_t>(descriptor.endianess));
+    return hash;
+  }
+};
+
+template <typename DataModelType, std::size_t... I>
+constexpr auto make_data_model_descriptor(
+    std::index_sequence<I...> /*unused*/) -> DataModelDescriptor {
+  // NOLINTBEGIN(google-runtime-int)
+  using Types = std::tuple<char, unsigned char, signed char, wchar_t, short,
+                           unsigned short, int, unsigned int, long,
+                           unsigned long, long long, unsigned long long, float,
+                           double, long double, bool>;
+  // NOLINTEND(google-runtime-int)
+  return DataModelDescriptor{
+      {{DataModelType::template get_size<
+          typename std::tuple_element<I, Types>::type>()...}},
+      {{DataModelType::template get_alignment<
+          typename std::tuple_element<I, Types>::type>()...}},
+      DataModelType::get_endianess()};
+}
+
+template <typename DataModelType>
+constexpr auto make_data_model_descriptor() -> DataModelDescriptor {
+  return make_data_model_descriptor<DataModelType>(
+      std::make_index_sequence<kDataModelTypeCount>{});
+}
+
+// From size and alignment pairs in DataModel's template parameter order.
+inline auto make_data_model_descriptor(
+    const std::array<std::size_t, 2 * kDataModelTypeCount>& values,
+    little_pp::Endianess endianess) -> DataModelDescriptor {
+  DataModelDescriptor descriptor{};
+  for (std::size_t i = 0; i < kDataModelTypeCount; ++i) {
+    descriptor.sizes[i] = values[2 * i];
+    descriptor.alignments[i] = values[2 * i + 1];
+  }
+  descriptor.endianess = endianess;
+  return descriptor;
+}
+
+enum class SchemaNodeKind : unsigned char {
+  kScalar,
+  // followed by `count` members
+  kClass,
+  // followed by the element type's nodes
+  kArray,
+};
+
+struct SchemaNode {
+  SchemaNodeKind kind;
+  // kScalar: the DataModelTypeIndex of the scalar type
+  std::size_t type_index;
+  ValueKind value_kind;
+  // kClass: the field count; kArray: the element count
+  std::size_t count;
+};
+
+template <typename MemberType, typename = void>
+struct MemberSchema {
+  static_assert(IsSerializableType<MemberType>::kValue,
+                "Field type not supported.");
+};
+
+template <typename SerializableClassType>
+struct TypeSchema;
+
+template <typename MemberType>
+struct MemberSchema<
+    MemberType,
+    typename std::enable_if<IsScalarField<MemberType>::kValue>::type> {
+  static constexpr std::size_t kNodeCount = 1;
+
+  static constexpr auto make_nodes()
+      -> ConstexprArray<SchemaNode, kNodeCount> {
+    return ConstexprArray<SchemaNode, kNodeCount>{{SchemaNode{
+        SchemaNodeKind::kScalar,
+        DataModelTypeIndex<typename FieldScalar<MemberType>::Type>::kValue,
+        FieldValueKind<MemberType>::kValue, 0}}};
+  }
+};
+
+template <typename MemberType>
+struct MemberSchema<
+    MemberType,
+    typename std::enable_if<IsNestedClass<MemberType>::kValue>::type>
+    : TypeSchema<MemberType> {};
+
+template <typename ElementType, std::size_t N>
+struct MemberSchema<std::array<ElementType, N>, void> {
+  using ElementSchema = MemberSchema<ElementType>;
+  static constexpr std::size_t kNodeCount = 1 + ElementSchema::kNodeCount;
+
+  static constexpr auto make_nodes()
+      -> ConstexprArray<SchemaNode, kNodeCount> {
+    ConstexprArray<SchemaNode, kNodeCount> nodes{};
+    nodes[0] = SchemaNode{SchemaNodeKind::kArray, 0, ValueKind::kUnsigned, N};
+    const ConstexprArray<SchemaNode, ElementSchema::kNodeCount> element =
+        ElementSchema::make_nodes();
+    for (std::size_t i = 0; i < ElementSchema::kNodeCount; ++i) {
+      nodes[1 + i] = element[i];
+    }
+    return nodes;
+  }
+};
+
+template <typename SerializableClassType>
+struct TypeSchema {
+  static constexpr std::size_t kFieldCount =
+      boost::pfr::tuple_size_v<SerializableClassType>;
+
+  template <std::size_t I>
+  using FieldSchema =
+      MemberSchema<boost::pfr::tuple_element_t<I, SerializableClassType>>;
+
+  template <std::size_t... I>
+  static constexpr auto count_nodes(std::index_sequence<I...> /*unused*/)
+      -> std::size_t {
+    std::size_t count = 1;
+    using Expander = std::size_t[];
+    (void)Expander{0, (count += FieldSchema<I>::kNodeCount)...};
+    return count;
+  }
+
+  static constexpr std::size_t kNodeCount =
+      count_nodes(std::make_index_sequence<kFieldCount>{});
+
+  template <std::size_t I>
+  static constexpr auto append_nodes(
+      ConstexprArray<SchemaNode, kNodeCount>& nodes, std::size_t next)
+      -> std::size_t {
+    const ConstexprArray<SchemaNode, FieldSchema<I>::kNodeCount> field =
+        FieldSchema<I>::make_nodes();
+    for (std::size_t i = 0; i < FieldSchema<I>::kNodeCount; ++i) {
+      nodes[next + i] = field[i];
+    }
+    return next + FieldSchema<I>::kNodeCount;
+  }
+
+  template <std::size_t... I>
+  static constexpr auto make_nodes(std::index_sequence<I...> /*unused*/)
+      -> ConstexprArray<SchemaNode, kNodeCount> {
+    ConstexprArray<SchemaNode, kNodeCount> nodes{};
+    nodes[0] = SchemaNode{SchemaNodeKind::kClass, 0, ValueKind::kUnsigned,
+                          kFieldCount};
+    std::size_t next = 1;
+    using Expander = std::size_t[];
+    (void)Expander{0, (next = append_nodes<I>(nodes, next))...};
+    (void)next;  // unused when the class has no fields
+    return nodes;
+  }
+
+  static constexpr auto make_nodes()
+      -> ConstexprArray<SchemaNode, kNodeCount> {
+    return make_nodes(std::make_index_sequence<kFieldCount>{});
+  }
+
+  static constexpr ConstexprArray<SchemaNode, kNodeCount> kNodes =
+      make_nodes();
+};
+
+template <typename SerializableClassType>
+constexpr ConstexprArray<SchemaNode,
+                         TypeSchema<SerializableClassType>::kNodeCount>
+    TypeSchema<SerializableClassType>::kNodes;
+
+// A class's layout under a DataModelDescriptor; see Layout for the meaning of
+// each member.
+struct RuntimeLayout {
+  std::size_t size;
+  std::size_t alignment;
+  std::vector<FieldLayout> leaves;
+  std::vector<PaddingRun> padding_runs;
+};
+
+// Descriptors typically come from another device, so the sizes and
+// alignments of the scalars a class uses are checked before any layout
+// arithmetic: build() throws std::invalid_argument for a size of 0, an
+// alignment that is not a power of two, or either above
+// kMaxRuntimeLayoutSize.
+class RuntimeLayoutBuilder {
+ public:
+  RuntimeLayoutBuilder(const DataModelDescriptor& data_model,
+                       const SchemaNode* nodes)
+      : data_model_(data_model), nodes_(nodes) {}
+
+  auto build() -> RuntimeLayout {
+    RuntimeLayout layout{0, 0, {}, {}};
+    const MemberExtent extent = lay_out_member(layout.leaves);
+    layout.size = extent.size;
+    layout.alignment = extent.alignment;
+
+    std::size_t filled = 0;
+    for (const FieldLayout& leaf : layout.leaves) {
+      if (leaf.offset > filled) {
+        layout.padding_runs.push_back(PaddingRun{filled, leaf.offset - filled});
+      }
+      filled = leaf.offset + leaf.size;
+    }
+    // account for trailing padding
+    if (layout.size > filled) {
+      layout.padding_runs.push_back(PaddingRun{filled, layout.size - filled});
+    }
+    return layout;
+  }
+
+ private:
+  struct MemberExtent {
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  // Lays out the member at the next node, appending its leaves with offsets
+  // relative to the member.
+  auto lay_out_member(std::vector<FieldLayout>& leaves) -> MemberExtent {
+    const SchemaNode node = nodes_[next_node_];
+    next_node_++;
+    switch (node.kind) {
+      case SchemaNodeKind::kScalar: {
+        const MemberExtent extent{data_model_.sizes[node.type_index],
+                                  data_model_.alignments[node.type_index]};
+        validate_scalar(extent);
+        leaves.push_back(FieldLayout{0, extent.size, extent.alignment,
+                                     node.value_kind});
+        return extent;
+      }
+      case SchemaNodeKind::kClass: {
+        MemberExtent extent{0, 0};
+        std::size_t filled = 0;
+        for (std::size_t i = 0; i < node.count; ++i) {
+          const std::size_t first_leaf = leaves.size();
+          const MemberExtent field = lay_out_member(leaves);
+          const std::size_t offset = checked_align_up(filled, field.alignment);
+          for (std::size_t j = first_leaf; j < leaves.size(); ++j) {
+            leaves[j].offset += offset;
+          }
+          filled = checked_add(offset, field.size);
+          if (field.alignment > extent.alignment) {
+            extent.alignment = field.alignment;
+          }
+        }
+        extent.size = checked_align_up(filled, extent.alignment);
+        return extent;
+      }
+      case SchemaNodeKind::kArray: {
+        const std::size_t first_leaf = leaves.size();
+        const MemberExtent element = lay_out_member(leaves);
+        const std::size_t element_leaf_count = leaves.size() - first_leaf;
+        const std::size_t size = checked_multiply(node.count, element.size);
+        if (node.count == 0) {
+          leaves.resize(first_leaf);
+        }
+        for (std::size_t i = 1; i < node.count; ++i) {
+          for (std::size_t j = 0; j < element_leaf_count; ++j) {
+            FieldLayout leaf = leaves[first_leaf + j];
+            leaf.offset += i * element.size;
+            leaves.push_back(leaf);
+          }
+        }
+        return MemberExtent{size, element.alignment};
+      }
+    }
+    return MemberExtent{0, 0};
+  }
+
+  static void validate_scalar(const MemberExtent& extent) {
+    if (extent.size == 0 || extent.size > kMaxRuntimeLayoutSize) {
+      throw std::invalid_argument(
+          "Data model sizes must be between 1 and 2^32 - 1 bytes.");
+    }
+    if (extent.alignment == 0 ||
+        (extent.alignment & (extent.alignment - 1)) != 0 ||
+        extent.alignment > kMaxRuntimeLayoutSize) {
+      throw std::invalid_argument(
+          "Data model alignments must be powers of two below 2^32.");
+    }
+  }
+
+  // Descriptor sizes are only bounded by kMaxRuntimeLayoutSize, so layout
+  // arithmetic can wrap around std::size_t on 32-bit hosts.
+  static auto checked_add(std::size_t a, std::size_t b) -> std::size_t {
+    if (b > SIZE_MAX - a) {
+      throw std::invalid_argument("The layout's size overflows std::size_t.");
+    }
+    return a + b;
+  }
+
+  static auto checked_multiply(std::size_t a, std::size_t b) -> std::size_t {
+    if (a != 0 && b > SIZE_MAX / a) {
+      throw std::invalid_argument("The layout's size overflows std::size_t.");
+    }
+    return a * b;
+  }
+
+  static auto checked_align_up(std::size_t value, std::size_t alignment)
+      -> std::size_t {
+    if (alignment != 0) {
+      checked_add(value, alignment - 1);
+    }
+    return align_up(value, alignment);
+  }
+
+  const DataModelDescriptor& data_model_;
+  const SchemaNode* nodes_;
+  std::size_t next_node_ = 0;
+};
+
+// Throws like RuntimeLayoutBuilder::build().
+template <typename SerializableClassType>
+inline auto make_runtime_layout(const DataModelDescriptor& data_model)
+    -> RuntimeLayout {
+  return RuntimeLayoutBuilder(data_model,
+                              TypeSchema<SerializableClassType>::kNodes.values)
+      .build();
+}
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_RUNTIME_DATA_MODEL_H
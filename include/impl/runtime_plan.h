@@ -0,0 +1,549 @@
+// ABOUT: Conversion plans between a class's native layout and its layout
+//        under a DataModelDescriptor. The plan compiler runs CopyPlan's
+//        algorithm at runtime over the two layouts' leaves and emits a compact
+//        program per direction:
+//          - kCopy: contiguous fields share one op, and identical layouts are
+//            a single copy, padding included.
+//          - kZero: destination padding.
+//          - kConvert: a field whose width or byte order changes.
+//          - kReverse: a byte-order change of a field wider than 64 bits.
+//
+//        Each op carries a kernel chosen when the plan is compiled: copies and
+//        zeroing of up to kMaxFixedKernelSize bytes, and every conversion, are
+//        instantiations of fixed-size code (conversions are the compile-time
+//        path's apply_convert_run), so no kernel branches on sizes or byte
+//        orders. Kernels are strided over records, and a program runs op by
+//        op over a block of records: the cost of dispatching an op is shared
+//        by the block, and each op is a tight loop of the same code the
+//        compile-time path inlines. Blocks are small enough to stay in L1.
+//
+//        Compiling a plan allocates; plans are therefore cached per class and
+//        descriptor, in a cache that is safe to use from any thread. Cached
+//        plans are never evicted, so references to them stay valid.
+
+#ifndef LITTLE_PP_IMPL_RUNTIME_PLAN_H
+#define LITTLE_PP_IMPL_RUNTIME_PLAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../data_model.h"
+#include "field_layout.h"
+#include "layout.h"
+#include "native_layout.h"
+#include "runtime_data_model.h"
+#include "serialization.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+// Applies an op to `count` records; the i-th record's bytes start at
+// src + i * src_stride and dst + i * dst_stride. `size` is the op's size, for
+// kernels that are not specialized on it.
+using RuntimeKernel = void (*)(const unsigned char* src, std::size_t src_stride,
+                               unsigned char* dst, std::size_t dst_stride,
+                               std::size_t count, std::size_t size);
+
+// Records per block when running a program over many records.
+constexpr std::size_t kRuntimeBlockSize = 64;
+
+// Copies and zeroing up to this size get fixed-size kernels.
+constexpr std::size_t kMaxFixedKernelSize = 16;
+
+template <std::size_t kSize>
+void copy_kernel(const unsigned char* src, std::size_t src_stride,
+                 unsigned char* dst, std::size_t dst_stride, std::size_t count,
+                 std::size_t /*size*/) {
+  for (std::size_t i = 0; i < count; ++i) {
+    std::memcpy(dst + i * dst_stride, src + i * src_stride, kSize);
+  }
+}
+
+inline void copy_any_kernel(const unsigned char* src, std::size_t src_stride,
+                            unsigned char* dst, std::size_t dst_stride,
+                            std::size_t count, std::size_t size) {
+  for (std::size_t i = 0; i < count; ++i) {
+    std::memcpy(dst + i * dst_stride, src + i * src_stride, size);
+  }
+}
+
+template <std::size_t kSize>
+void zero_kernel(const unsigned char* /*src*/, std::size_t /*src_stride*/,
+                 unsigned char* dst, std::size_t dst_stride, std::size_t count,
+                 std::size_t /*size*/) {
+  for (std::size_t i = 0; i < count; ++i) {
+    std::memset(dst + i * dst_stride, 0, kSize);
+  }
+}
+
+inline void zero_any_kernel(const unsigned char* /*src*/,
+                            std::size_t /*src_stride*/, unsigned char* dst,
+                            std::size_t dst_stride, std::size_t count,
+                            std::size_t size) {
+  for (std::size_t i = 0; i < count; ++i) {
+    std::memset(dst + i * dst_stride, 0, size);
+  }
+}
+
+inline void reverse_kernel(const unsigned char* src, std::size_t src_stride,
+                           unsigned char* dst, std::size_t dst_stride,
+                           std::size_t count, std::size_t size) {
+  for (std::size_t i = 0; i < count; ++i) {
+    for (std::size_t j = 0; j < size; ++j) {
+      dst[i * dst_stride + j] = src[i * src_stride + size - 1 - j];
+    }
+  }
+}
+
+template <std::size_t... I>
+constexpr auto make_copy_kernels(std::index_sequence<I...> /*unused*/)
+    -> ConstexprArray<RuntimeKernel, sizeof...(I)> {
+  return ConstexprArray<RuntimeKernel, sizeof...(I)>{
+      {&copy_kernel<I + 1>...}};
+}
+
+template <std::size_t... I>
+constexpr auto make_zero_kernels(std::index_sequence<I...> /*unused*/)
+    -> ConstexprArray<RuntimeKernel, sizeof...(I)> {
+  return ConstexprArray<RuntimeKernel, sizeof...(I)>{
+      {&zero_kernel<I + 1>...}};
+}
+
+// Converters exist for every width in {1, 2, 4, 8} bytes, every value kind
+// and byte order pair, except floating-point width changes.
+constexpr std::size_t kConvertedWidthCount = 4;
+constexpr std::size_t kValueKindCount = 3;
+constexpr std::size_t kEndianessCount = 2;
+constexpr std::size_t kConvertKernelCount =
+    kConvertedWidthCount * kConvertedWidthCount * kValueKindCount *
+    kEndianessCount * kEndianessCount;
+
+constexpr auto get_width(std::size_t width_index) -> std::size_t {
+  return std::size_t{1} << width_index;
+}
+
+// -1 for widths without converters.
+inline auto get_width_index(std::size_t width) -> int {
+  switch (width) {
+    case 1:
+      return 0;
+    case 2:
+      return 1;
+    case 4:
+      return 2;
+    case 8:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+constexpr auto get_convert_kernel_index(std::size_t src_width_index,
+                                        std::size_t dst_width_index,
+                                        ValueKind value_kind,
+                                        little_pp::Endianess src_endianess,
+                                        little_pp::Endianess dst_endianess)
+    -> std::size_t {
+  return (((src_width_index * kConvertedWidthCount + dst_width_index) *
+               kValueKindCount +
+           static_cast<std::size_t>(value_kind)) *
+              kEndianessCount +
+          static_cast<std::size_t>(src_endianess)) *
+             kEndianessCount +
+         static_cast<std::size_t>(dst_endianess);
+}
+
+// The inverse of get_convert_kernel_index.
+template <std::size_t kIndex>
+struct ConvertKernel {
+  static constexpr little_pp::Endianess kDstEndianess =
+      static_cast<little_pp::Endianess>(kIndex % kEndianessCount);
+  static constexpr little_pp::Endianess kSrcEndianess =
+      static_cast<little_pp::Endianess>(kIndex / kEndianessCount %
+                                        kEndianessCount);
+  static constexpr ValueKind kValueKind = static_cast<ValueKind>(
+      kIndex / (kEndianessCount * kEndianessCount) % kValueKindCount);
+  static constexpr std::size_t kDstSize = get_width(
+      kIndex / (kEndianessCount * kEndianessCount * kValueKindCount) %
+      kConvertedWidthCount);
+  static constexpr std::size_t kSrcSize =
+      get_width(kIndex / (kEndianessCount * kEndianessCount *
+                          kValueKindCount * kConvertedWidthCount));
+  static constexpr bool kIsSupported =
+      kValueKind != ValueKind::kFloatingPoint || kSrcSize == kDstSize;
+
+  static void apply(const unsigned char* src, std::size_t src_stride,
+                    unsigned char* dst, std::size_t dst_stride,
+                    std::size_t count, std::size_t /*size*/) {
+    for (std::size_t i = 0; i < count; ++i) {
+      apply_convert_run<kSrcSize, kDstSize, kValueKind, kSrcEndianess,
+                        kDstEndianess>(src + i * src_stride,
+                                       dst + i * dst_stride);
+    }
+  }
+
+  // nullptr for unsupported conversions, which must not be instantiated.
+  template <bool kIsSupportedCopy = kIsSupported>
+  static constexpr auto get() ->
+      typename std::enable_if<kIsSupportedCopy, RuntimeKernel>::type {
+    return &apply;
+  }
+
+  template <bool kIsSupportedCopy = kIsSupported>
+  static constexpr auto get() ->
+      typename std::enable_if<!kIsSupportedCopy, RuntimeKernel>::type {
+    return nullptr;
+  }
+};
+
+template <std::size_t... I>
+constexpr auto make_convert_kernels(std::index_sequence<I...> /*unused*/)
+    -> ConstexprArray<RuntimeKernel, sizeof...(I)> {
+  return ConstexprArray<RuntimeKernel, sizeof...(I)>{
+      {ConvertKernel<I>::get()...}};
+}
+
+template <typename Unused = void>
+struct RuntimeKernels {
+  static constexpr ConstexprArray<RuntimeKernel, kMaxFixedKernelSize> kCopy =
+      make_copy_kernels(std::make_index_sequence<kMaxFixedKernelSize>{});
+  static constexpr ConstexprArray<RuntimeKernel, kMaxFixedKernelSize> kZero =
+      make_zero_kernels(std::make_index_sequence<kMaxFixedKernelSize>{});
+  static constexpr ConstexprArray<RuntimeKernel, kConvertKernelCount>
+      kConvert =
+          make_convert_kernels(std::make_index_sequence<kConvertKernelCount>{});
+};
+
+template <typename Unused>
+constexpr ConstexprArray<RuntimeKernel, kMaxFixedKernelSize>
+    RuntimeKernels<Unused>::kCopy;
+template <typename Unused>
+constexpr ConstexprArray<RuntimeKernel, kMaxFixedKernelSize>
+    RuntimeKernels<Unused>::kZero;
+template <typename Unused>
+constexpr ConstexprArray<RuntimeKernel, kConvertKernelCount>
+    RuntimeKernels<Unused>::kConvert;
+
+enum class RuntimeOpKind : unsigned char {
+  kCopy,
+  kZero,
+  kConvert,
+  kReverse,
+};
+
+struct RuntimeOp {
+  RuntimeOpKind kind;
+  std::uint32_t src_offset;
+  std::uint32_t dst_offset;
+  // the bytes written
+  std::uint32_t size;
+  RuntimeKernel kernel;
+};
+
+using RuntimeProgram = std::vector<RuntimeOp>;
+
+// Runs `program` over `count` records of src_stride and dst_stride bytes.
+inline void run_program(const RuntimeProgram& program,
+                        const unsigned char* src, std::size_t src_stride,
+                        unsigned char* dst, std::size_t dst_stride,
+                        std::size_t count) {
+  for (std::size_t first = 0; first < count; first += kRuntimeBlockSize) {
+    const std::size_t block_count = (count - first < kRuntimeBlockSize)
+                                        ? count - first
+                                        : kRuntimeBlockSize;
+    const unsigned char* block_src = src + first * src_stride;
+    unsigned char* block_dst = dst + first * dst_stride;
+    for (const RuntimeOp& op : program) {
+      op.kernel(block_src + op.src_offset, src_stride,
+                block_dst + op.dst_offset, dst_stride, block_count, op.size);
+    }
+  }
+}
+
+class RuntimeProgramCompiler {
+ public:
+  RuntimeProgramCompiler(const std::vector<FieldLayout>& src_leaves,
+                         std::size_t src_size,
+                         little_pp::Endianess src_endianess,
+                         const std::vector<FieldLayout>& dst_leaves,
+                         std::size_t dst_size,
+                         little_pp::Endianess dst_endianess)
+      : src_leaves_(src_leaves),
+        src_size_(src_size),
+        src_endianess_(src_endianess),
+        dst_leaves_(dst_leaves),
+        dst_size_(dst_size),
+        dst_endianess_(dst_endianess) {}
+
+  // Throws std::invalid_argument for conversions the compile-time path does
+  // not support either.
+  auto compile() -> RuntimeProgram {
+    RuntimeProgram program;
+    // as in CopyPlan, identical layouts are copied whole, padding included
+    if (is_identity()) {
+      if (dst_size_ > 0) {
+        append_copy(program, 0, 0, dst_size_);
+      }
+      return finish(program);
+    }
+    std::size_t dst_filled = 0;
+    for (std::size_t i = 0; i < src_leaves_.size(); ++i) {
+      const FieldLayout& src = src_leaves_[i];
+      const FieldLayout& dst = dst_leaves_[i];
+      if (dst.offset > dst_filled) {
+        program.push_back(make_op(RuntimeOpKind::kZero, 0, dst_filled,
+                                  dst.offset - dst_filled, nullptr));
+      }
+      const bool is_converted =
+          src.size != dst.size ||
+          (src_endianess_ != dst_endianess_ && src.size > 1);
+      if (!is_converted) {
+        append_copy(program, src.offset, dst.offset, src.size);
+      } else if (src.size == dst.size && get_width_index(src.size) < 0) {
+        program.push_back(make_op(RuntimeOpKind::kReverse, src.offset,
+                                  dst.offset, src.size, &reverse_kernel));
+      } else {
+        program.push_back(make_op(RuntimeOpKind::kConvert, src.offset,
+                                  dst.offset, dst.size,
+                                  find_convert_kernel(src, dst)));
+      }
+      dst_filled = dst.offset + dst.size;
+    }
+    // account for trailing padding
+    if (dst_size_ > dst_filled) {
+      program.push_back(make_op(RuntimeOpKind::kZero, 0, dst_filled,
+                                dst_size_ - dst_filled, nullptr));
+    }
+    return finish(program);
+  }
+
+ private:
+  // See LayoutIdentical.
+  auto is_identity() const -> bool {
+    if (src_size_ != dst_size_) {
+      return false;
+    }
+    for (std::size_t i = 0; i < src_leaves_.size(); ++i) {
+      const FieldLayout& src = src_leaves_[i];
+      const FieldLayout& dst = dst_leaves_[i];
+      if (src.offset != dst.offset || src.size != dst.size) {
+        return false;
+      }
+      if (src_endianess_ != dst_endianess_ && src.size > 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto find_convert_kernel(const FieldLayout& src, const FieldLayout& dst) const
+      -> RuntimeKernel {
+    const int src_width_index = get_width_index(src.size);
+    const int dst_width_index = get_width_index(dst.size);
+    if (src_width_index < 0 || dst_width_index < 0) {
+      throw std::invalid_argument(
+          "Converting the width of a field wider than 64 bits is not "
+          "supported.");
+    }
+    const RuntimeKernel kernel =
+        RuntimeKernels<>::kConvert[get_convert_kernel_index(
+            static_cast<std::size_t>(src_width_index),
+            static_cast<std::size_t>(dst_width_index), src.value_kind,
+            src_endianess_, dst_endianess_)];
+    if (kernel == nullptr) {
+      throw std::invalid_argument(
+          "Converting the width of a floating-point field is not "
+          "supported.");
+    }
+    return kernel;
+  }
+
+  // RuntimePlan rejects layouts larger than kMaxRuntimeLayoutSize, so every
+  // offset and size fits the op's 32-bit fields.
+  static auto make_op(RuntimeOpKind kind, std::size_t src_offset,
+                      std::size_t dst_offset, std::size_t size,
+                      RuntimeKernel kernel) -> RuntimeOp {
+    return RuntimeOp{kind, static_cast<std::uint32_t>(src_offset),
+                     static_cast<std::uint32_t>(dst_offset),
+                     static_cast<std::uint32_t>(size), kernel};
+  }
+
+  // Copies that are contiguous in both layouts are merged.
+  static void append_copy(RuntimeProgram& program, std::size_t src_offset,
+                          std::size_t dst_offset, std::size_t size) {
+    if (!program.empty()) {
+      RuntimeOp& previous = program.back();
+      if (previous.kind == RuntimeOpKind::kCopy &&
+          previous.src_offset + previous.size == src_offset &&
+          previous.dst_offset + previous.size == dst_offset) {
+        previous.size = static_cast<std::uint32_t>(previous.size + size);
+        return;
+      }
+    }
+    program.push_back(
+        make_op(RuntimeOpKind::kCopy, src_offset, dst_offset, size, nullptr));
+  }
+
+  // Picks copy and zero kernels once their sizes are final.
+  static auto finish(RuntimeProgram& program) -> RuntimeProgram {
+    for (RuntimeOp& op : program) {
+      const bool is_fixed = op.size <= kMaxFixedKernelSize;
+      if (op.kind == RuntimeOpKind::kCopy) {
+        op.kernel =
+            is_fixed ? RuntimeKernels<>::kCopy[op.size - 1] : &copy_any_kernel;
+      } else if (op.kind == RuntimeOpKind::kZero) {
+        op.kernel =
+            is_fixed ? RuntimeKernels<>::kZero[op.size - 1] : &zero_any_kernel;
+      }
+    }
+    return std::move(program);
+  }
+
+  const std::vector<FieldLayout>& src_leaves_;
+  std::size_t src_size_;
+  little_pp::Endianess src_endianess_;
+  const std::vector<FieldLayout>& dst_leaves_;
+  std::size_t dst_size_;
+  little_pp::Endianess dst_endianess_;
+};
+
+template <typename SerializableClassType, typename NativeDataModelType>
+class RuntimePlan {
+ public:
+  using NativeLayout = Layout<SerializableClassType, NativeDataModelType>;
+
+  // Throws std::invalid_argument if the descriptor is invalid (see
+  // RuntimeLayoutBuilder), if the layout is larger than
+  // kMaxRuntimeLayoutSize, or if a field cannot be converted between the two
+  // data models.
+  explicit RuntimePlan(const DataModelDescriptor& data_model)
+      : data_model_(data_model),
+        layout_(make_runtime_layout<SerializableClassType>(data_model)) {
+    static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                  "Serialized class type must be trivially copyable.");
+    static_assert(
+        NativeLayoutMatches<SerializableClassType,
+                            NativeDataModelType>::kValue,
+        "NativeDataModelType does not describe this architecture's layout of "
+        "the class.");
+    static_assert(NativeLayout::kSize <= kMaxRuntimeLayoutSize,
+                  "Classes larger than 2^32 - 1 bytes are not supported.");
+    if (layout_.size > kMaxRuntimeLayoutSize) {
+      throw std::invalid_argument(
+          "Layouts larger than 2^32 - 1 bytes are not supported.");
+    }
+    const std::vector<FieldLayout> native_leaves(
+        NativeLayout::kLeaves.values,
+        NativeLayout::kLeaves.values + NativeLayout::kLeafCount);
+    const little_pp::Endianess native_endianess =
+        NativeDataModelType::get_endianess();
+    serialize_program_ =
+        RuntimeProgramCompiler(native_leaves, NativeLayout::kSize,
+                               native_endianess, layout_.leaves, layout_.size,
+                               data_model.endianess)
+            .compile();
+    deserialize_program_ =
+        RuntimeProgramCompiler(layout_.leaves, layout_.size,
+                               data_model.endianess, native_leaves,
+                               NativeLayout::kSize, native_endianess)
+            .compile();
+  }
+
+  auto get_data_model() const -> const DataModelDescriptor& {
+    return data_model_;
+  }
+
+  auto get_layout() const -> const RuntimeLayout& { return layout_; }
+
+  // The serialized size under the descriptor.
+  auto get_size() const -> std::size_t { return layout_.size; }
+
+  void serialize(const SerializableClassType& object,
+                 unsigned char* dst) const {
+    serialize_n(&object, dst, 1);
+  }
+
+  void deserialize(const unsigned char* src,
+                   SerializableClassType& object) const {
+    deserialize_n(src, &object, 1);
+  }
+
+  // Serializes `count` objects into consecutive records; much faster per
+  // record than serialize() for more than a few records.
+  void serialize_n(const SerializableClassType* objects, unsigned char* dst,
+                   std::size_t count) const {
+    run_program(serialize_program_,
+                reinterpret_cast<const unsigned char*>(objects),
+                sizeof(SerializableClassType), dst, layout_.size, count);
+  }
+
+  void deserialize_n(const unsigned char* src, SerializableClassType* objects,
+                     std::size_t count) const {
+    run_program(deserialize_program_, src, layout_.size,
+                reinterpret_cast<unsigned char*>(objects),
+                sizeof(SerializableClassType), count);
+  }
+
+  auto get_serialize_program() const -> const RuntimeProgram& {
+    return serialize_program_;
+  }
+
+  auto get_deserialize_program() const -> const RuntimeProgram& {
+    return deserialize_program_;
+  }
+
+ private:
+  DataModelDescriptor data_model_;
+  RuntimeLayout layout_;
+  RuntimeProgram serialize_program_;
+  RuntimeProgram deserialize_program_;
+};
+
+template <typename SerializableClassType, typename NativeDataModelType>
+class RuntimePlanCache {
+ public:
+  using Plan = RuntimePlan<SerializableClassType, NativeDataModelType>;
+
+  // The plan for `data_model`, compiled on first use. Throws like Plan's
+  // constructor; failures are not cached.
+  static auto get(const DataModelDescriptor& data_model) -> const Plan& {
+    Cache& cache = get_cache();
+    const std::lock_guard<std::mutex> lock(cache.mutex);
+    auto found = cache.plans.find(data_model);
+    if (found == cache.plans.end()) {
+      found = cache.plans
+                  .emplace(data_model, std::unique_ptr<const Plan>(
+                                           new Plan(data_model)))
+                  .first;
+    }
+    return *found->second;
+  }
+
+ private:
+  struct Cache {
+    std::mutex mutex;
+    std::unordered_map<DataModelDescriptor, std::unique_ptr<const Plan>,
+                       DataModelDescriptorHash>
+        plans;
+  };
+
+  static auto get_cache() -> Cache& {
+    static Cache cache;
+    return cache;
+  }
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_RUNTIME_PLAN_H
@@ -0,0 +1,439 @@
+// ABOUT: The serialization engine. A CopyPlan turns the field layouts of a
+//        class under a source and a destination data model into a
+//        compile-time list of runs (nested members are flattened, so a field
+//        here is always a scalar leaf, see layout.h):
+//          - kCopy: a contiguous span that can be memcpy'd as-is; adjacent
+//            fields that are contiguous in both layouts share one run.
+//          - kConvert: a single field whose width or byte order changes.
+//          - kZero: destination padding.
+//          - kMaskedCopy: like kCopy, but the span also contains destination
+//            padding that must keep its current value; it is blended into the
+//            destination a word at a time with a constant mask.
+//        Runs are ordered by destination offset. When both layouts are
+//        identical the plan is a single kCopy of the whole class. Applying a
+//        plan expands the runs through an index_sequence, so the generated
+//        code is straight-line with every offset and size a constant; no
+//        field metadata is looped over at runtime.
+//
+//        The PaddingPolicy decides what happens to destination padding:
+//          - kZero: zeroed, so the output is deterministic. Runs cover every
+//            destination byte.
+//          - kPreserve: keeps whatever the destination buffer held. Fields
+//            separated by at most a word of padding are merged into one
+//            kMaskedCopy (a read-modify-write of the padding bytes).
+//          - kSkip: never read or written. Every run stops at the padding, so
+//            fields are written with split stores.
+
+#ifndef LITTLE_PP_IMPL_SERIALIZATION_H
+#define LITTLE_PP_IMPL_SERIALIZATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "../data_model.h"
+#include "byte_order.h"
+#include "field_layout.h"
+#include "layout.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+enum class PaddingPolicy {
+  kZero,
+  kPreserve,
+  kSkip,
+};
+
+enum class RunKind {
+  kCopy,
+  kConvert,
+  kZero,
+  kMaskedCopy,
+};
+
+struct CopyRun {
+  RunKind kind;
+  std::size_t src_offset;
+  std::size_t dst_offset;
+  // For kCopy and kMaskedCopy both sizes are equal; for kZero src_size is 0.
+  std::size_t src_size;
+  std::size_t dst_size;
+  ValueKind value_kind;
+};
+
+template <std::size_t kSize>
+inline void apply_copy_run(const unsigned char* src, unsigned char* dst) {
+  std::memcpy(dst, src, kSize);
+}
+
+template <std::size_t kSize>
+inline void apply_zero_run(unsigned char* dst) {
+  std::memset(dst, 0, kSize);
+}
+
+// dst = (src & mask) | (dst & ~mask) for one Word.
+template <typename Word>
+inline void blend_word(const unsigned char* src, const unsigned char* mask,
+                       unsigned char* dst) {
+  Word src_word;
+  Word mask_word;
+  Word dst_word;
+  std::memcpy(&src_word, src, sizeof(Word));
+  std::memcpy(&mask_word, mask, sizeof(Word));
+  std::memcpy(&dst_word, dst, sizeof(Word));
+  dst_word = static_cast<Word>((src_word & mask_word) |
+                               (dst_word & static_cast<Word>(~mask_word)));
+  std::memcpy(dst, &dst_word, sizeof(Word));
+}
+
+// Blends with the widest word that fits the run. A run that is not a multiple
+// of the word ends with one overlapping word; blending a byte twice gives the
+// same result.
+template <std::size_t kSize>
+inline void apply_masked_copy_run(const unsigned char* src,
+                                  const unsigned char* mask,
+                                  unsigned char* dst) {
+  using Word = typename std::conditional<
+      (kSize >= 8), std::uint64_t,
+      typename std::conditional<
+          (kSize >= 4), std::uint32_t,
+          typename std::conditional<(kSize >= 2), std::uint16_t,
+                                    std::uint8_t>::type>::type>::type;
+  constexpr std::size_t kWordSize = sizeof(Word);
+  for (std::size_t i = 0; i + kWordSize <= kSize; i += kWordSize) {
+    blend_word<Word>(src + i, mask + i, dst + i);
+  }
+  if (kSize % kWordSize != 0) {
+    blend_word<Word>(src + kSize - kWordSize, mask + kSize - kWordSize,
+                     dst + kSize - kWordSize);
+  }
+}
+
+template <std::size_t kSrcSize, std::size_t kDstSize, ValueKind kValueKind,
+          little_pp::Endianess kSrcEndianess,
+          little_pp::Endianess kDstEndianess>
+inline auto apply_convert_run(const unsigned char* src, unsigned char* dst) ->
+    typename std::enable_if<(kSrcSize <= sizeof(std::uint64_t) &&
+                             kDstSize <= sizeof(std::uint64_t))>::type {
+  static_assert(kValueKind != ValueKind::kFloatingPoint || kSrcSize == kDstSize,
+                "Converting the width of a floating-point field is not "
+                "supported.");
+  std::uint64_t value = load_uint<kSrcSize, kSrcEndianess>(src);
+  if (kValueKind == ValueKind::kSigned) {
+    value = sign_extend<kSrcSize>(value);
+  }
+  // narrowing keeps the low-order bytes, like a static_cast
+  store_uint<kDstSize, kDstEndianess>(dst, value);
+}
+
+// Fields wider than 64 bits (e.g. long double) can only change byte order.
+template <std::size_t kSrcSize, std::size_t kDstSize, ValueKind kValueKind,
+          little_pp::Endianess kSrcEndianess,
+          little_pp::Endianess kDstEndianess>
+inline auto apply_convert_run(const unsigned char* src, unsigned char* dst) ->
+    typename std::enable_if<!(kSrcSize <= sizeof(std::uint64_t) &&
+                              kDstSize <= sizeof(std::uint64_t))>::type {
+  static_assert(kSrcSize == kDstSize,
+                "Converting the width of a field wider than 64 bits is not "
+                "supported.");
+  copy_reversed<kSrcSize>(src, dst);
+}
+
+// Two data models lay a class out identically when every (leaf) field has the
+// same offset and size, the class has the same size and alignment, and
+// multi-byte fields share a byte order. Data models may still differ for types
+// the class does not use.
+template <typename SerializableClassType, typename DataModelTypeA,
+          typename DataModelTypeB>
+struct LayoutIdentical {
+  using LayoutA = Layout<SerializableClassType, DataModelTypeA>;
+  using LayoutB = Layout<SerializableClassType, DataModelTypeB>;
+
+  static constexpr auto is_identical() -> bool {
+    if (LayoutA::kSize != LayoutB::kSize ||
+        LayoutA::kAlignment != LayoutB::kAlignment) {
+      return false;
+    }
+    const bool is_same_endianess =
+        DataModelTypeA::get_endianess() == DataModelTypeB::get_endianess();
+    for (std::size_t i = 0; i < LayoutA::kLeafCount; ++i) {
+      const FieldLayout field_a = LayoutA::kLeaves[i];
+      const FieldLayout field_b = LayoutB::kLeaves[i];
+      if (field_a.offset != field_b.offset || field_a.size != field_b.size) {
+        return false;
+      }
+      if (!is_same_endianess && field_a.size > 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static constexpr bool kValue = is_identical();
+};
+
+// Copy runs separated by at most this much padding are merged into one
+// kMaskedCopy under PaddingPolicy::kPreserve: a single word blend is cheaper
+// than two stores.
+constexpr std::size_t kMaxMaskedGap = sizeof(std::uint64_t);
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType,
+          PaddingPolicy kPaddingPolicy = PaddingPolicy::kZero>
+struct CopyPlan {
+  using SrcLayout = Layout<SerializableClassType, SrcDataModelType>;
+  using DstLayout = Layout<SerializableClassType, DstDataModelType>;
+
+  static constexpr little_pp::Endianess kSrcEndianess =
+      SrcDataModelType::get_endianess();
+  static constexpr little_pp::Endianess kDstEndianess =
+      DstDataModelType::get_endianess();
+
+  // Nested members are flattened; the plan only sees scalar leaves.
+  static constexpr std::size_t kLeafCount = SrcLayout::kLeafCount;
+  // every leaf plus the padding before it, plus trailing padding
+  static constexpr std::size_t kMaxRunCount = 2 * kLeafCount + 1;
+
+  struct Runs {
+    ConstexprArray<CopyRun, kMaxRunCount> runs;
+    std::size_t count;
+  };
+
+  static constexpr void append_zero_run(Runs& result, std::size_t dst_offset,
+                                        std::size_t size) {
+    result.runs[result.count] =
+        CopyRun{RunKind::kZero, 0, dst_offset, 0, size, ValueKind::kUnsigned};
+    result.count++;
+  }
+
+  static constexpr void append_copy_run(Runs& result, std::size_t src_offset,
+                                        std::size_t dst_offset,
+                                        std::size_t size) {
+    if (result.count > 0) {
+      CopyRun& previous = result.runs[result.count - 1];
+      if (previous.kind == RunKind::kCopy &&
+          previous.src_offset + previous.src_size == src_offset &&
+          previous.dst_offset + previous.dst_size == dst_offset) {
+        previous.src_size += size;
+        previous.dst_size += size;
+        return;
+      }
+      // Same displacement in both layouts, so the span from the previous run
+      // through this one lines up; the padding between them is masked out.
+      const std::size_t previous_end = previous.dst_offset + previous.dst_size;
+      if (kPaddingPolicy == PaddingPolicy::kPreserve &&
+          (previous.kind == RunKind::kCopy ||
+           previous.kind == RunKind::kMaskedCopy) &&
+          dst_offset - previous_end <= kMaxMaskedGap &&
+          src_offset - previous.src_offset ==
+              dst_offset - previous.dst_offset) {
+        previous.kind = RunKind::kMaskedCopy;
+        previous.dst_size = dst_offset + size - previous.dst_offset;
+        previous.src_size = previous.dst_size;
+        return;
+      }
+    }
+    result.runs[result.count] = CopyRun{RunKind::kCopy, src_offset, dst_offset,
+                                        size, size, ValueKind::kUnsigned};
+    result.count++;
+  }
+
+  static constexpr bool kIsIdentity =
+      LayoutIdentical<SerializableClassType, SrcDataModelType,
+                      DstDataModelType>::kValue;
+  static constexpr bool kWritesPadding =
+      kPaddingPolicy == PaddingPolicy::kZero;
+  // Identical layouts are copied whole, padding included, as one run. Only
+  // kZero may write the source's padding bytes to the destination.
+  static constexpr bool kIsSingleCopy = kIsIdentity && kWritesPadding;
+
+  static constexpr auto make_runs() -> Runs {
+    Runs result{};
+    if (kIsSingleCopy) {
+      if (DstLayout::kSize > 0) {
+        append_copy_run(result, 0, 0, DstLayout::kSize);
+      }
+      return result;
+    }
+
+    std::size_t dst_filled = 0;
+    for (std::size_t i = 0; i < kLeafCount; ++i) {
+      const std::size_t src_offset = SrcLayout::kLeaves[i].offset;
+      const std::size_t dst_offset = DstLayout::kLeaves[i].offset;
+      const std::size_t src_size = SrcLayout::kLeaves[i].size;
+      const std::size_t dst_size = DstLayout::kLeaves[i].size;
+
+      if (kWritesPadding && dst_offset > dst_filled) {
+        append_zero_run(result, dst_filled, dst_offset - dst_filled);
+      }
+
+      const bool is_converted =
+          (src_size != dst_size) ||
+          (kSrcEndianess != kDstEndianess && src_size > 1);
+      if (is_converted) {
+        result.runs[result.count] =
+            CopyRun{RunKind::kConvert, src_offset, dst_offset, src_size,
+                    dst_size, SrcLayout::kLeaves[i].value_kind};
+        result.count++;
+      } else {
+        append_copy_run(result, src_offset, dst_offset, src_size);
+      }
+      dst_filled = dst_offset + dst_size;
+    }
+
+    // account for trailing padding
+    if (kWritesPadding && DstLayout::kSize > dst_filled) {
+      append_zero_run(result, dst_filled, DstLayout::kSize - dst_filled);
+    }
+    return result;
+  }
+
+  static constexpr std::size_t kRunCount = make_runs().count;
+
+  static constexpr auto make_exact_runs()
+      -> ConstexprArray<CopyRun, kRunCount> {
+    ConstexprArray<CopyRun, kRunCount> exact{};
+    const Runs all = make_runs();
+    for (std::size_t i = 0; i < kRunCount; ++i) {
+      exact[i] = all.runs[i];
+    }
+    return exact;
+  }
+
+  static constexpr ConstexprArray<CopyRun, kRunCount> kRuns = make_exact_runs();
+
+  // 0xFF for every destination byte that holds a field, 0 for padding; the
+  // blend mask of kMaskedCopy runs.
+  static constexpr auto make_field_byte_mask()
+      -> ConstexprArray<unsigned char, DstLayout::kSize> {
+    ConstexprArray<unsigned char, DstLayout::kSize> mask{};
+    for (std::size_t i = 0; i < kLeafCount; ++i) {
+      for (std::size_t b = 0; b < DstLayout::kLeaves[i].size; ++b) {
+        mask[DstLayout::kLeaves[i].offset + b] = 0xFF;
+      }
+    }
+    return mask;
+  }
+
+  static constexpr ConstexprArray<unsigned char, DstLayout::kSize>
+      kFieldByteMask = make_field_byte_mask();
+
+  // Each write_run overload writes run I to `run_dst`, the run's first
+  // destination byte.
+  template <std::size_t I>
+  static void write_run(const unsigned char* src, unsigned char* run_dst,
+                        std::integral_constant<RunKind, RunKind::kCopy>
+                        /*unused*/) {
+    constexpr CopyRun kRun = kRuns[I];
+    apply_copy_run<kRun.src_size>(src + kRun.src_offset, run_dst);
+  }
+
+  template <std::size_t I>
+  static void write_run(const unsigned char* /*unused*/,
+                        unsigned char* run_dst,
+                        std::integral_constant<RunKind, RunKind::kZero>
+                        /*unused*/) {
+    constexpr CopyRun kRun = kRuns[I];
+    apply_zero_run<kRun.dst_size>(run_dst);
+  }
+
+  template <std::size_t I>
+  static void write_run(const unsigned char* src, unsigned char* run_dst,
+                        std::integral_constant<RunKind, RunKind::kMaskedCopy>
+                        /*unused*/) {
+    constexpr CopyRun kRun = kRuns[I];
+    apply_masked_copy_run<kRun.dst_size>(
+        src + kRun.src_offset, kFieldByteMask.values + kRun.dst_offset,
+        run_dst);
+  }
+
+  template <std::size_t I>
+  static void write_run(const unsigned char* src, unsigned char* run_dst,
+                        std::integral_constant<RunKind, RunKind::kConvert>
+                        /*unused*/) {
+    constexpr CopyRun kRun = kRuns[I];
+    apply_convert_run<kRun.src_size, kRun.dst_size, kRun.value_kind,
+                      kSrcEndianess, kDstEndianess>(src + kRun.src_offset,
+                                                    run_dst);
+  }
+
+  template <std::size_t I>
+  static void write_run(const unsigned char* src, unsigned char* run_dst) {
+    write_run<I>(src, run_dst,
+                 std::integral_constant<RunKind, kRuns[I].kind>{});
+  }
+
+  template <std::size_t... I>
+  static void apply_runs(const unsigned char* src, unsigned char* dst,
+                         std::index_sequence<I...> /*unused*/) {
+    // pack expansion in an initializer list is sequenced left-to-right
+    using Expander = int[];
+    (void)Expander{0, (write_run<I>(src, dst + kRuns[I].dst_offset), 0)...};
+  }
+
+  // For code that walks the plan with a runtime cursor (e.g. chunked
+  // streaming), write_run<I> for every run, indexed by run.
+  using RunWriter = void (*)(const unsigned char*, unsigned char*);
+
+  template <std::size_t... I>
+  static constexpr auto make_run_writers(std::index_sequence<I...> /*unused*/)
+      -> ConstexprArray<RunWriter, kRunCount> {
+    return ConstexprArray<RunWriter, kRunCount>{{&write_run<I>...}};
+  }
+
+  static constexpr ConstexprArray<RunWriter, kRunCount> kRunWriters =
+      make_run_writers(std::make_index_sequence<kRunCount>{});
+
+  static constexpr auto make_max_converted_size() -> std::size_t {
+    std::size_t max_size = 0;
+    for (std::size_t i = 0; i < kRunCount; ++i) {
+      if (kRuns[i].kind == RunKind::kConvert && kRuns[i].dst_size > max_size) {
+        max_size = kRuns[i].dst_size;
+      }
+    }
+    return max_size;
+  }
+
+  // The widest destination field that is converted rather than copied.
+  static constexpr std::size_t kMaxConvertedSize = make_max_converted_size();
+
+  static void apply(const unsigned char* src, unsigned char* dst) {
+    apply_runs(src, dst, std::make_index_sequence<kRunCount>{});
+  }
+};
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType, PaddingPolicy kPaddingPolicy>
+constexpr ConstexprArray<
+    CopyRun, CopyPlan<SerializableClassType, SrcDataModelType,
+                      DstDataModelType, kPaddingPolicy>::kRunCount>
+    CopyPlan<SerializableClassType, SrcDataModelType, DstDataModelType,
+             kPaddingPolicy>::kRuns;
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType, PaddingPolicy kPaddingPolicy>
+constexpr ConstexprArray<
+    unsigned char, CopyPlan<SerializableClassType, SrcDataModelType,
+                            DstDataModelType, kPaddingPolicy>::DstLayout::kSize>
+    CopyPlan<SerializableClassType, SrcDataModelType, DstDataModelType,
+             kPaddingPolicy>::kFieldByteMask;
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType, PaddingPolicy kPaddingPolicy>
+constexpr ConstexprArray<
+    typename CopyPlan<SerializableClassType, SrcDataModelType,
+                      DstDataModelType, kPaddingPolicy>::RunWriter,
+    CopyPlan<SerializableClassType, SrcDataModelType, DstDataModelType,
+             kPaddingPolicy>::kRunCount>
+    CopyPlan<SerializableClassType, SrcDataModelType, DstDataModelType,
+             kPaddingPolicy>::kRunWriters;
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_SERIALIZATION_H
@@ -0,0 +1,134 @@
+// ABOUT: Field-at-a-time access to a class serialized in some data model,
+//        without converting the rest of the class. A field's offset and size
+//        are constants of the class's Layout, so get<I>() compiles to a
+//        single (possibly byte-swapped) load or store. A class member is
+//        accessed through a nested view of the member, which costs nothing
+//        beyond the pointer offset.
+
+#ifndef LITTLE_PP_IMPL_SERIALIZED_VIEW_H
+#define LITTLE_PP_IMPL_SERIALIZED_VIEW_H
+
+#include <boost/pfr/core.hpp>
+#include <cstddef>
+#include <type_traits>
+
+#include "field_access.h"
+#include "layout.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+template <typename SerializableClassType, typename DataModelType>
+class SerializedView {
+ public:
+  using LayoutType = Layout<SerializableClassType, DataModelType>;
+  template <std::size_t I>
+  using FieldType = boost::pfr::tuple_element_t<I, SerializableClassType>;
+
+  // get<I>() of a class member returns a view of the member.
+  template <std::size_t I>
+  using GetType = typename std::conditional<
+      IsNestedClass<FieldType<I>>::kValue,
+      SerializedView<FieldType<I>, DataModelType>, FieldType<I>>::type;
+
+  // `data` must span LayoutType::kSize bytes and outlive the view.
+  explicit SerializedView(const unsigned char* data) : data_(data) {}
+
+  template <std::size_t I>
+  auto get() const -> GetType<I> {
+    static_assert(I < LayoutType::kFieldCount, "Field index out of range.");
+    static_assert(!IsStdArray<FieldType<I>>::value,
+                  "std::array members cannot be accessed through a view.");
+    return get<I>(
+        std::integral_constant<bool, IsNestedClass<FieldType<I>>::kValue>{});
+  }
+
+  auto get_data() const -> const unsigned char* { return data_; }
+
+ private:
+  template <std::size_t I>
+  auto get(std::false_type /*unused*/) const -> GetType<I> {
+    return load_field<FieldType<I>, LayoutType::kFields[I].size,
+                      DataModelType::get_endianess()>(
+        data_ + LayoutType::kFields[I].offset);
+  }
+
+  template <std::size_t I>
+  auto get(std::true_type /*unused*/) const -> GetType<I> {
+    return GetType<I>(data_ + LayoutType::kFields[I].offset);
+  }
+
+  const unsigned char* data_;
+};
+
+// The writable counterpart of SerializedView. set<I>() stores a single field;
+// padding and every other field are left untouched. Members of a class member
+// are set through the nested reference that get<I>() returns. ByteType may be
+// `volatile unsigned char` for memory-mapped images, in which case each
+// serialized byte of the field is accessed exactly once, as a byte.
+template <typename SerializableClassType, typename DataModelType,
+          typename ByteType = unsigned char>
+class SerializedRef {
+ public:
+  using LayoutType = Layout<SerializableClassType, DataModelType>;
+  template <std::size_t I>
+  using FieldType = boost::pfr::tuple_element_t<I, SerializableClassType>;
+
+  static_assert(
+      std::is_same<typename std::remove_cv<ByteType>::type,
+                   unsigned char>::value &&
+          !std::is_const<ByteType>::value,
+      "ByteType must be unsigned char, optionally volatile-qualified.");
+
+  template <std::size_t I>
+  using GetType = typename std::conditional<
+      IsNestedClass<FieldType<I>>::kValue,
+      SerializedRef<FieldType<I>, DataModelType, ByteType>,
+      FieldType<I>>::type;
+
+  // `data` must span LayoutType::kSize bytes and outlive the reference.
+  explicit SerializedRef(ByteType* data) : data_(data) {}
+
+  template <std::size_t I>
+  auto get() const -> GetType<I> {
+    static_assert(I < LayoutType::kFieldCount, "Field index out of range.");
+    static_assert(!IsStdArray<FieldType<I>>::value,
+                  "std::array members cannot be accessed through a view.");
+    return get<I>(
+        std::integral_constant<bool, IsNestedClass<FieldType<I>>::kValue>{});
+  }
+
+  template <std::size_t I>
+  void set(const FieldType<I>& value) const {
+    static_assert(I < LayoutType::kFieldCount, "Field index out of range.");
+    static_assert(!IsNestedClass<FieldType<I>>::kValue,
+                  "Set the members of a class member through get<I>().");
+    store_field<FieldType<I>, LayoutType::kFields[I].size,
+                DataModelType::get_endianess()>(
+        data_ + LayoutType::kFields[I].offset, value);
+  }
+
+  auto get_data() const -> ByteType* { return data_; }
+
+ private:
+  template <std::size_t I>
+  auto get(std::false_type /*unused*/) const -> GetType<I> {
+    return load_field<FieldType<I>, LayoutType::kFields[I].size,
+                      DataModelType::get_endianess()>(
+        data_ + LayoutType::kFields[I].offset);
+  }
+
+  template <std::size_t I>
+  auto get(std::true_type /*unused*/) const -> GetType<I> {
+    return GetType<I>(data_ + LayoutType::kFields[I].offset);
+  }
+
+  ByteType* data_;
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_SERIALIZED_VIEW_H
@@ -0,0 +1,229 @@
+// ABOUT: A native shadow copy of a device's register block, which is laid out
+//        in the device's data model. Fields are written to the shadow and
+//        marked dirty; syncing turns the dirty fields into as few bus write
+//        transactions (offset and length in the device layout) as the bus
+//        constraints allow. On a SPI or I2C bus every transaction carries
+//        microseconds of fixed overhead, so minimizing their number matters
+//        far more than the bytes copied.
+//
+//        Each dirty field is a span of the device layout, widened to the bus
+//        access width and trimmed so that it never starts inside the previous
+//        transaction. Spans are visited in offset order and merged while
+//        the clean gap between them is at most merge_gap bytes (rewriting a
+//        few clean bytes with their current value is cheaper than opening
+//        another transaction) and the merged transaction fits max_burst.
+//        Transactions longer than max_burst are split.
+
+#ifndef LITTLE_PP_IMPL_SHADOW_REGISTERS_H
+#define LITTLE_PP_IMPL_SHADOW_REGISTERS_H
+
+#include <boost/pfr/core.hpp>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "field_layout.h"
+#include "layout.h"
+#include "native_layout.h"
+#include "serialization.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+struct RegisterWriteOptions {
+  // Clean bytes between two dirty spans that are rewritten rather than split
+  // into a second transaction; roughly the bytes the bus moves in the time
+  // one transaction's overhead takes.
+  std::size_t merge_gap = 4;
+  // The longest transaction the bus accepts; 0 for no limit. Must be a
+  // multiple of access_width.
+  std::size_t max_burst = 0;
+  // Transactions start and end on multiples of this many bytes (clamped to
+  // the end of the register block).
+  std::size_t access_width = 1;
+};
+
+struct WriteTransaction {
+  std::size_t offset;
+  std::size_t size;
+};
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DeviceDataModelType>
+class ShadowRegisters {
+ public:
+  using DeviceLayout = Layout<SerializableClassType, DeviceDataModelType>;
+  template <std::size_t I>
+  using FieldType = boost::pfr::tuple_element_t<I, SerializableClassType>;
+  static constexpr std::size_t kFieldCount = DeviceLayout::kFieldCount;
+  static constexpr std::size_t kDeviceSize = DeviceLayout::kSize;
+
+  // Every field starts dirty: nothing is known to be on the device yet.
+  // Throws std::invalid_argument if `options` are inconsistent.
+  explicit ShadowRegisters(const SerializableClassType& initial = {},
+                           const RegisterWriteOptions& options = {})
+      : shadow_(initial), options_(options) {
+    static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                  "Register class type must be trivially copyable.");
+    static_assert(
+        NativeLayoutMatches<SerializableClassType, SrcDataModelType>::kValue,
+        "SrcDataModelType does not describe this architecture's layout of "
+        "the class.");
+    if (options_.access_width == 0) {
+      throw std::invalid_argument("access_width must not be 0");
+    }
+    if (options_.max_burst % options_.access_width != 0) {
+      throw std::invalid_argument(
+          "max_burst must be a multiple of access_width");
+    }
+    mark_all_dirty();
+  }
+
+  template <std::size_t I>
+  auto get() const -> const FieldType<I>& {
+    return boost::pfr::get<I>(shadow_);
+  }
+
+  auto get_object() const -> const SerializableClassType& { return shadow_; }
+
+  // Marks field I dirty unless `value` is bitwise equal to the shadow's.
+  template <std::size_t I>
+  void set(const FieldType<I>& value) {
+    static_assert(I < kFieldCount, "Field index out of range.");
+    FieldType<I>& field = boost::pfr::get<I>(shadow_);
+    if (std::memcmp(&field, &value, sizeof(FieldType<I>)) != 0) {
+      field = value;
+      dirty_[I] = true;
+    }
+  }
+
+  // For registers whose device value may have changed behind our back.
+  template <std::size_t I>
+  void mark_dirty() {
+    static_assert(I < kFieldCount, "Field index out of range.");
+    dirty_[I] = true;
+  }
+
+  void mark_all_dirty() { set_all_dirty(true); }
+
+  auto is_dirty() const -> bool {
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      if (dirty_[i]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Calls `visit(WriteTransaction)` for every transaction the dirty fields
+  // need, in offset order. Returns the number of transactions.
+  template <typename Visitor>
+  auto plan(Visitor&& visit) const -> std::size_t {
+    std::size_t count = 0;
+    bool has_pending = false;
+    WriteTransaction pending{0, 0};
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      const FieldLayout& field = DeviceLayout::kFields[i];
+      // an empty class member has nothing to write
+      if (!dirty_[i] || field.size == 0) {
+        continue;
+      }
+      std::size_t start = align_down(field.offset);
+      const std::size_t end = align_end(field.offset + field.size);
+      if (has_pending) {
+        const std::size_t pending_end = pending.offset + pending.size;
+        // widening may reach back into bytes the pending transaction writes
+        if (end <= pending_end) {
+          continue;
+        }
+        if (start < pending_end) {
+          start = pending_end;
+        }
+      }
+      const bool is_merged =
+          has_pending && start <= pending.offset + pending.size +
+                                      options_.merge_gap &&
+          (options_.max_burst == 0 ||
+           end - pending.offset <= options_.max_burst);
+      if (is_merged) {
+        if (end > pending.offset + pending.size) {
+          pending.size = end - pending.offset;
+        }
+        continue;
+      }
+      if (has_pending) {
+        count += emit(pending, visit);
+      }
+      pending = WriteTransaction{start, end - start};
+      has_pending = true;
+    }
+    if (has_pending) {
+      count += emit(pending, visit);
+    }
+    return count;
+  }
+
+  // Serializes the shadow and calls `write(offset, bytes, size)` for every
+  // planned transaction, `bytes` pointing at the transaction's first byte of
+  // the device image; then marks every field clean. Returns the number of
+  // transactions.
+  template <typename Writer>
+  auto sync(Writer&& write) -> std::size_t {
+    CopyPlan<SerializableClassType, SrcDataModelType,
+             DeviceDataModelType>::apply(reinterpret_cast<const unsigned char*>(
+                                             &shadow_),
+                                         image_);
+    const std::size_t count = plan([&](const WriteTransaction& transaction) {
+      write(transaction.offset, image_ + transaction.offset, transaction.size);
+    });
+    set_all_dirty(false);
+    return count;
+  }
+
+  // The device image as of the last sync().
+  auto get_image() const -> const unsigned char* { return image_; }
+
+ private:
+  void set_all_dirty(bool is_dirty) {
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      dirty_[i] = is_dirty;
+    }
+  }
+
+  auto align_down(std::size_t offset) const -> std::size_t {
+    return offset / options_.access_width * options_.access_width;
+  }
+
+  auto align_end(std::size_t end) const -> std::size_t {
+    const std::size_t aligned = align_up(end, options_.access_width);
+    return (aligned > kDeviceSize) ? kDeviceSize : aligned;
+  }
+
+  // Emits `transaction`, split into bursts; returns the number emitted.
+  template <typename Visitor>
+  auto emit(WriteTransaction transaction, Visitor& visit) const
+      -> std::size_t {
+    std::size_t count = 0;
+    while (options_.max_burst != 0 && transaction.size > options_.max_burst) {
+      visit(WriteTransaction{transaction.offset, options_.max_burst});
+      transaction.offset += options_.max_burst;
+      transaction.size -= options_.max_burst;
+      count++;
+    }
+    visit(transaction);
+    return count + 1;
+  }
+
+  SerializableClassType shadow_;
+  RegisterWriteOptions options_;
+  bool dirty_[(kFieldCount > 0) ? kFieldCount : 1] = {};
+  unsigned char image_[(kDeviceSize > 0) ? kDeviceSize : 1] = {};
+};
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_SHADOW_REGISTERS_H
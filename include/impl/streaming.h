@@ -0,0 +1,318 @@
+// ABOUT: Serialization into and from buffers smaller than the serialized
+//        class, e.g. fixed-size DMA or UART chunks. The state is a cursor into
+//        the CopyPlan: the current run and how many of its bytes were already
+//        emitted (or consumed). Copy and padding runs go straight between the
+//        chunk and the object; only a converted field split across two chunks
+//        goes through a field-sized scratch buffer. No full-size staging
+//        buffer is needed.
+//
+//        Deserialization walks the same runs, which read the serialized bytes
+//        in offset order (see checksummed_conversion.h). Serialized padding
+//        is the gap before a run (or after the last one) and is skipped
+//        without being stored; the object's padding is zeroed by the plan's
+//        kZero runs, which consume no input.
+
+#ifndef LITTLE_PP_IMPL_STREAMING_H
+#define LITTLE_PP_IMPL_STREAMING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "native_layout.h"
+#include "serialization.h"
+
+namespace litte_pp {
+
+namespace impl {
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+class ChunkedSerializer {
+ public:
+  using Plan =
+      CopyPlan<SerializableClassType, SrcDataModelType, DstDataModelType>;
+  static constexpr std::size_t kSerializedSize = Plan::DstLayout::kSize;
+
+  // `object` must outlive the serializer (or the next reset()).
+  explicit ChunkedSerializer(const SerializableClassType& object) {
+    static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                  "Serialized class type must be trivially copyable.");
+    static_assert(
+        NativeLayoutMatches<SerializableClassType, SrcDataModelType>::kValue,
+        "SrcDataModelType does not describe this architecture's layout of "
+        "the class.");
+    reset(object);
+  }
+
+  // Restarts serialization from the first byte, optionally of a new object.
+  void reset(const SerializableClassType& object) {
+    src_ = reinterpret_cast<const unsigned char*>(&object);
+    reset();
+  }
+
+  void reset() {
+    run_index_ = 0;
+    run_offset_ = 0;
+    written_ = 0;
+  }
+
+  // Writes the next serialized bytes into `chunk`. Returns the number of
+  // bytes written, which is less than `capacity` only once the end of the
+  // serialized class is reached.
+  auto write(unsigned char* chunk, std::size_t capacity) -> std::size_t {
+    std::size_t written = 0;
+    while (written < capacity && run_index_ < Plan::kRunCount) {
+      const CopyRun& run = Plan::kRuns[run_index_];
+      const std::size_t run_remaining = run.dst_size - run_offset_;
+      const std::size_t count = (run_remaining < capacity - written)
+                                    ? run_remaining
+                                    : capacity - written;
+
+      switch (run.kind) {
+        // kMaskedCopy is only planned under PaddingPolicy::kPreserve; the
+        // serializer's plan zeroes padding.
+        case RunKind::kCopy:
+        case RunKind::kMaskedCopy:
+          std::memcpy(chunk + written, src_ + run.src_offset + run_offset_,
+                      count);
+          break;
+        case RunKind::kZero:
+          std::memset(chunk + written, 0, count);
+          break;
+        case RunKind::kConvert:
+          if (count == run.dst_size) {
+            Plan::kRunWriters[run_index_](src_, chunk + written);
+          } else {
+            // the field straddles chunks; convert it whole, emit a slice
+            unsigned char field[kFieldBufferSize];
+            Plan::kRunWriters[run_index_](src_, field);
+            std::memcpy(chunk + written, field + run_offset_, count);
+          }
+          break;
+      }
+
+      written += count;
+      run_offset_ += count;
+      if (run_offset_ == run.dst_size) {
+        run_index_++;
+        run_offset_ = 0;
+      }
+    }
+    written_ += written;
+    return written;
+  }
+
+  auto is_done() const -> bool { return run_index_ == Plan::kRunCount; }
+
+  auto get_remaining_size() const -> std::size_t {
+    return kSerializedSize - written_;
+  }
+
+ private:
+  static constexpr std::size_t kFieldBufferSize =
+      (Plan::kMaxConvertedSize > 0) ? Plan::kMaxConvertedSize : 1;
+
+  const unsigned char* src_ = nullptr;
+  std::size_t run_index_ = 0;
+  std::size_t run_offset_ = 0;
+  std::size_t written_ = 0;
+};
+
+// The smallest unsigned type that holds kMax; keeps decoder cursors small.
+template <std::size_t kMax>
+using CursorType = typename std::conditional<
+    (kMax <= UINT8_MAX), std::uint8_t,
+    typename std::conditional<(kMax <= UINT16_MAX), std::uint16_t,
+                              std::size_t>::type>::type;
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+class ChunkedDeserializer {
+ public:
+  using Plan =
+      CopyPlan<SerializableClassType, SrcDataModelType, DstDataModelType>;
+  static constexpr std::size_t kSerializedSize = Plan::SrcLayout::kSize;
+
+  // `object` must outlive the deserializer (or the next reset()).
+  explicit ChunkedDeserializer(SerializableClassType& object) {
+    static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                  "Deserialized class type must be trivially copyable.");
+    static_assert(
+        NativeLayoutMatches<SerializableClassType, DstDataModelType>::kValue,
+        "DstDataModelType does not describe this architecture's layout of "
+        "the class.");
+    reset(object);
+  }
+
+  // Restarts at the first byte of a frame, optionally into a new object.
+  void reset(SerializableClassType& object) {
+    dst_ = reinterpret_cast<unsigned char*>(&object);
+    reset();
+  }
+
+  void reset() {
+    run_index_ = 0;
+    consumed_ = 0;
+  }
+
+  // Consumes the next serialized bytes from `fragment`, storing every field
+  // into the object as soon as its last byte is consumed. Returns the number
+  // of bytes consumed, which is less than `size` only once the end of the
+  // serialized class is reached; the rest belongs to the next frame.
+  auto read(const unsigned char* fragment, std::size_t size) -> std::size_t {
+    std::size_t position = 0;
+    while (run_index_ < Plan::kRunCount) {
+      const CopyRun& run = Plan::kRuns[run_index_];
+      if (run.kind == RunKind::kZero) {
+        std::memset(dst_ + run.dst_offset, 0, run.dst_size);
+        run_index_++;
+        continue;
+      }
+      if (position == size) {
+        return position;
+      }
+      const std::size_t available = size - position;
+      if (consumed_ < run.src_offset) {
+        position += skip(run.src_offset, available);
+        continue;
+      }
+
+      const std::size_t run_offset = consumed_ - run.src_offset;
+      const std::size_t run_remaining = run.src_size - run_offset;
+      const std::size_t count =
+          (run_remaining < available) ? run_remaining : available;
+      if (run.kind == RunKind::kConvert) {
+        if (count == run.src_size) {
+          kFieldConverters[run_index_](fragment + position,
+                                       dst_ + run.dst_offset);
+        } else {
+          // the field straddles fragments; convert it once it is whole
+          std::memcpy(field_ + run_offset, fragment + position, count);
+          if (count == run_remaining) {
+            kFieldConverters[run_index_](field_, dst_ + run.dst_offset);
+          }
+        }
+      } else {
+        std::memcpy(dst_ + run.dst_offset + run_offset, fragment + position,
+                    count);
+      }
+      position += count;
+      consumed_ = static_cast<Cursor>(consumed_ + count);
+      if (count == run_remaining) {
+        run_index_++;
+      }
+    }
+    // trailing serialized padding
+    return position + skip(kSerializedSize, size - position);
+  }
+
+  // Consumes one byte; returns whether it completed the object. A byte pushed
+  // after the object was completed starts the next frame, as if reset() had
+  // been called first, rather than being dropped.
+  auto push(unsigned char byte) -> bool {
+    if (is_done()) {
+      reset();
+    }
+    read(&byte, 1);
+    return is_done();
+  }
+
+  auto is_done() const -> bool {
+    return run_index_ == Plan::kRunCount && consumed_ == kSerializedSize;
+  }
+
+  auto get_remaining_size() const -> std::size_t {
+    return kSerializedSize - consumed_;
+  }
+
+ private:
+  using Cursor = CursorType<kSerializedSize>;
+  using RunCursor = CursorType<Plan::kRunCount>;
+
+  // Skips serialized padding up to `end`; returns the bytes skipped.
+  auto skip(std::size_t end, std::size_t available) -> std::size_t {
+    const std::size_t padding = end - consumed_;
+    const std::size_t count = (padding < available) ? padding : available;
+    consumed_ = static_cast<Cursor>(consumed_ + count);
+    return count;
+  }
+
+  // Converts run I's field from its serialized bytes; a no-op for runs that
+  // are not kConvert.
+  using FieldConverter = void (*)(const unsigned char*, unsigned char*);
+
+  template <std::size_t I>
+  static void convert_field(const unsigned char* field_src,
+                            unsigned char* field_dst,
+                            std::true_type /*unused*/) {
+    constexpr CopyRun kRun = Plan::kRuns[I];
+    apply_convert_run<kRun.src_size, kRun.dst_size, kRun.value_kind,
+                      Plan::kSrcEndianess, Plan::kDstEndianess>(field_src,
+                                                                field_dst);
+  }
+
+  template <std::size_t I>
+  static void convert_field(const unsigned char* /*unused*/,
+                            unsigned char* /*unused*/,
+                            std::false_type /*unused*/) {}
+
+  template <std::size_t I>
+  static void convert_field(const unsigned char* field_src,
+                            unsigned char* field_dst) {
+    convert_field<I>(
+        field_src, field_dst,
+        std::integral_constant<bool,
+                               Plan::kRuns[I].kind == RunKind::kConvert>{});
+  }
+
+  template <std::size_t... I>
+  static constexpr auto make_field_converters(
+      std::index_sequence<I...> /*unused*/)
+      -> ConstexprArray<FieldConverter, Plan::kRunCount> {
+    return ConstexprArray<FieldConverter, Plan::kRunCount>{
+        {&convert_field<I>...}};
+  }
+
+  static constexpr auto make_max_src_converted_size() -> std::size_t {
+    std::size_t max_size = 0;
+    for (std::size_t i = 0; i < Plan::kRunCount; ++i) {
+      if (Plan::kRuns[i].kind == RunKind::kConvert &&
+          Plan::kRuns[i].src_size > max_size) {
+        max_size = Plan::kRuns[i].src_size;
+      }
+    }
+    return max_size;
+  }
+
+  static constexpr ConstexprArray<FieldConverter, Plan::kRunCount>
+      kFieldConverters = make_field_converters(
+          std::make_index_sequence<Plan::kRunCount>{});
+
+  static constexpr std::size_t kFieldBufferSize =
+      (make_max_src_converted_size() > 0) ? make_max_src_converted_size() : 1;
+
+  unsigned char* dst_ = nullptr;
+  RunCursor run_index_ = 0;
+  Cursor consumed_ = 0;
+  // the bytes of a converted field received so far
+  unsigned char field_[kFieldBufferSize] = {};
+};
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+constexpr ConstexprArray<
+    typename ChunkedDeserializer<SerializableClassType, SrcDataModelType,
+                                 DstDataModelType>::FieldConverter,
+    ChunkedDeserializer<SerializableClassType, SrcDataModelType,
+                        DstDataModelType>::Plan::kRunCount>
+    ChunkedDeserializer<SerializableClassType, SrcDataModelType,
+                        DstDataModelType>::kFieldConverters;
+
+}  // namespace impl
+
+}  // namespace litte_pp
+
+#endif  // LITTLE_PP_IMPL_STREAMING_H
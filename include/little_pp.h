@@ -1,6 +1,15 @@
 #ifndef LITTLE_PP_H
 #define LITTLE_PP_H
 
+#include "bit_fields.h"
+#include "checksum.h"
+#include "columns.h"
+#include "delta.h"
+#include "frame_ring.h"
 #include "padding_reflection.h"
+#include "serialized_view.h"
+#include "serialization.h"
+#include "shadow_registers.h"
+#include "streaming.h"
 
 #endif  // LITTLE_PP_H
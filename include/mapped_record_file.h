@@ -0,0 +1,32 @@
+// ABOUT: The public API for LittlePP's memory-mapped record files. This header
+//        needs POSIX (mmap), so it is not part of little_pp.h; use the
+//        //include:little_pp_posix target.
+#ifndef LITTLE_PP_MAPPED_RECORD_FILE_H
+#define LITTLE_PP_MAPPED_RECORD_FILE_H
+
+#include "data_model.h"
+#include "impl/mapped_record_file.h"
+
+namespace little_pp {
+namespace serialization {
+
+// A file of consecutive SerializableClassType records laid out in
+// FileDataModelType, converted to NativeDataModelType on access:
+//
+//   MappedRecordFile<LogEntry, CortexM4DataModel> log("flash.bin");
+//   const LogEntry last = log[log.size() - 1];  // converts one record
+//   for (const LogEntry entry : log) { ... }    // converts as it goes
+//   log.decode(first, count, entries.data());   // batch conversion
+//
+// Only the pages holding accessed records are read. A trailing partial record
+// is ignored (see get_trailing_byte_count()).
+template <typename SerializableClassType, typename FileDataModelType,
+          typename NativeDataModelType = little_pp::NativeDataModel>
+using MappedRecordFile =
+    litte_pp::impl::MappedRecordFile<SerializableClassType, FileDataModelType,
+                                     NativeDataModelType>;
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_MAPPED_RECORD_FILE_H
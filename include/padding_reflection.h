@@ -2,6 +2,9 @@
 #ifndef LITTLE_PP_PADDING_REFLECTION_H
 #define LITTLE_PP_PADDING_REFLECTION_H
 
+#include <climits>
+
+#include "impl/padding_analysis.h"
 #include "impl/padding_reflection.h"
 
 namespace little_pp {
@@ -52,6 +55,30 @@ constexpr std::array<std::size_t, serializable_class_padding_count_v<
     serializable_class_padding_indexes_v =
         litte_pp::impl::SerializableClassPaddingIndexes<SerializableClassType,
                                                         DataModelType>::kValue;
+
+// The class's size and padding under DataModelType, and what reordering its
+// direct members would save:
+//
+//   constexpr PaddingReport kReport =
+//       serializable_class_padding_report_v<SensorFrame, PeerDataModel>;
+//   static_assert(kReport.optimal_size == kReport.size,
+//                 "SensorFrame wastes bytes on the wire to the peer.");
+using PaddingReport = litte_pp::impl::PaddingReport;
+
+template <typename SerializableClassType, typename DataModelType>
+constexpr PaddingReport serializable_class_padding_report_v =
+    litte_pp::impl::PaddingAnalysis<SerializableClassType,
+                                    DataModelType>::kReport;
+
+// Indexes of the class's direct members (in declaration order), listed in the
+// order that minimizes padding under DataModelType.
+template <typename SerializableClassType, typename DataModelType>
+constexpr std::array<std::size_t, litte_pp::impl::PaddingAnalysis<
+                                      SerializableClassType,
+                                      DataModelType>::kFieldCount>
+    serializable_class_optimal_field_order_v =
+        litte_pp::impl::PaddingAnalysis<SerializableClassType,
+                                        DataModelType>::kOptimalOrder;
 // NOLINTEND(readability-identifier-naming)
 
 }  // namespace padding_reflection
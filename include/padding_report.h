@@ -0,0 +1,80 @@
+// ABOUT: The public API for LittlePP's JSON padding reports
+#ifndef LITTLE_PP_PADDING_REPORT_H
+#define LITTLE_PP_PADDING_REPORT_H
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <ostream>
+
+#include "impl/padding_report.h"
+#include "padding_reflection.h"
+
+namespace little_pp {
+namespace padding_reflection {
+
+// Writes serializable_class_padding_report_v and
+// serializable_class_optimal_field_order_v for each data model as one JSON
+// object (no trailing newline):
+//
+//   write_padding_report_json<SensorFrame, Lp64, CortexM4>(
+//       std::cout, "SensorFrame", {{"lp64", "cortex_m4"}});
+//
+//   {"class":"SensorFrame","field_count":3,"data_models":[{"name":"lp64",
+//    "size":24,"padding_bytes":8,"padding_ratio":0.333333,"optimal_size":16,
+//    "optimal_padding_bytes":0,"optimal_field_order":[1,0,2],
+//    "optimal_order_exact":true},...]}
+//
+// Field orders list member indexes in declaration order.
+template <typename SerializableClassType, typename... DataModelTypes>
+void write_padding_report_json(
+    std::ostream& out, const char* class_name,
+    const std::array<const char*, sizeof...(DataModelTypes)>&
+        data_model_names) {
+  litte_pp::impl::write_padding_report_json<SerializableClassType,
+                                            DataModelTypes...>(
+      out, class_name, data_model_names);
+}
+
+// The data models of a multi-class report, e.g. DataModels<Lp64, CortexM4>.
+template <typename... DataModelTypes>
+using DataModels = litte_pp::impl::DataModelList<DataModelTypes...>;
+
+// Writes write_padding_report_json's object for every class as one JSON array
+// (no trailing newline).
+template <typename DataModelListType, typename... SerializableClassTypes>
+void write_padding_reports_json(
+    std::ostream& out,
+    const std::array<const char*, sizeof...(SerializableClassTypes)>&
+        class_names,
+    const std::array<const char*, DataModelListType::kCount>&
+        data_model_names) {
+  litte_pp::impl::PaddingReportWriter<DataModelListType,
+                                      SerializableClassTypes...>::
+      write(out, class_names, data_model_names);
+}
+
+// The body of a padding report tool: prints the report of every class to
+// standard output and returns main()'s exit status.
+//
+//   auto main() -> int {
+//     return padding_report_main<DataModels<Lp64, CortexM4>, SensorFrame,
+//                                CommandFrame>(
+//         {{"SensorFrame", "CommandFrame"}}, {{"lp64", "cortex_m4"}});
+//   }
+template <typename DataModelListType, typename... SerializableClassTypes>
+auto padding_report_main(
+    const std::array<const char*, sizeof...(SerializableClassTypes)>&
+        class_names,
+    const std::array<const char*, DataModelListType::kCount>&
+        data_model_names) -> int {
+  write_padding_reports_json<DataModelListType, SerializableClassTypes...>(
+      std::cout, class_names, data_model_names);
+  std::cout << '\n' << std::flush;
+  return std::cout.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+}  // namespace padding_reflection
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_PADDING_REPORT_H
@@ -0,0 +1,40 @@
+// ABOUT: The public API for LittlePP's multi-threaded batch conversion. This
+//        header needs std::thread, so it is not part of little_pp.h; use the
+//        //include:little_pp_parallel target.
+#ifndef LITTLE_PP_PARALLEL_CONVERSION_H
+#define LITTLE_PP_PARALLEL_CONVERSION_H
+
+#include <cstddef>
+
+#include "impl/parallel_conversion.h"
+#include "serialization.h"
+
+namespace little_pp {
+namespace serialization {
+
+struct ParallelConversionOptions {
+  // 0 uses std::thread::hardware_concurrency(); the calling thread counts as
+  // one of the threads.
+  std::size_t thread_count = 0;
+  // Records converted per unit of work; 0 picks about 256 KiB of source
+  // records.
+  std::size_t chunk_record_count = 0;
+};
+
+// Same as convert_n, but chunks of records are converted concurrently. The
+// output is identical to convert_n's.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+inline void parallel_convert_n(const unsigned char* src, unsigned char* dst,
+                               std::size_t count,
+                               const ParallelConversionOptions& options = {}) {
+  litte_pp::impl::ParallelConversion<
+      SerializableClassType, SrcDataModelType,
+      DstDataModelType>::convert(src, dst, count, options.thread_count,
+                                 options.chunk_record_count);
+}
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_PARALLEL_CONVERSION_H
@@ -0,0 +1,66 @@
+// ABOUT: The public API for LittlePP's runtime-described data models
+#ifndef LITTLE_PP_RUNTIME_DATA_MODEL_H
+#define LITTLE_PP_RUNTIME_DATA_MODEL_H
+
+#include <array>
+#include <cstddef>
+
+#include "data_model.h"
+#include "impl/runtime_data_model.h"
+#include "impl/runtime_plan.h"
+
+namespace little_pp {
+namespace serialization {
+
+// A data model known only at runtime, e.g. reported by a device: the sizes
+// and alignments of DataModel's template parameters, plus a byte order.
+using DataModelDescriptor = litte_pp::impl::DataModelDescriptor;
+
+// The descriptor of a compile-time DataModel.
+template <typename DataModelType>
+constexpr auto make_data_model_descriptor() -> DataModelDescriptor {
+  return litte_pp::impl::make_data_model_descriptor<DataModelType>();
+}
+
+// `values` holds size and alignment pairs in DataModel's template parameter
+// order, i.e. the values a DataModel<...> spelling of the model would use.
+inline auto make_data_model_descriptor(
+    const std::array<std::size_t, 2 * litte_pp::impl::kDataModelTypeCount>&
+        values,
+    Endianess endianess) -> DataModelDescriptor {
+  return litte_pp::impl::make_data_model_descriptor(values, endianess);
+}
+
+// Converts a class between the native layout and its layout under a
+// descriptor. Constructing a plan compiles it (and allocates); use
+// get_runtime_plan to share one plan per descriptor:
+//
+//   const DataModelDescriptor device_model =
+//       make_data_model_descriptor(handshake.values, handshake.endianess);
+//   const auto& plan = get_runtime_plan<SensorFrame>(device_model);
+//   SensorFrame frame;
+//   plan.deserialize(bytes, frame);  // reads plan.get_size() bytes
+//
+// Plans throw std::invalid_argument when a field cannot be converted (a
+// floating-point or wider-than-64-bit field changing width).
+template <typename SerializableClassType,
+          typename NativeDataModelType = little_pp::NativeDataModel>
+using RuntimePlan =
+    litte_pp::impl::RuntimePlan<SerializableClassType, NativeDataModelType>;
+
+// The cached plan for `data_model`, compiled on the first call for the class
+// and descriptor. Safe to call from any thread; the reference stays valid for
+// the program's lifetime. The lookup takes a lock, so look a plan up once and
+// keep the reference rather than calling this per record.
+template <typename SerializableClassType,
+          typename NativeDataModelType = little_pp::NativeDataModel>
+auto get_runtime_plan(const DataModelDescriptor& data_model)
+    -> const RuntimePlan<SerializableClassType, NativeDataModelType>& {
+  return litte_pp::impl::RuntimePlanCache<
+      SerializableClassType, NativeDataModelType>::get(data_model);
+}
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_RUNTIME_DATA_MODEL_H
@@ -0,0 +1,128 @@
+// ABOUT: The public API for LittlePP's serialization features
+#ifndef LITTLE_PP_SERIALIZATION_H
+#define LITTLE_PP_SERIALIZATION_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "impl/batch_conversion.h"
+#include "impl/layout.h"
+#include "impl/native_layout.h"
+#include "impl/serialization.h"
+
+namespace little_pp {
+namespace serialization {
+
+// What serialization does with the destination's padding bytes:
+//   - kZero: zeroes them, so equal objects serialize to equal bytes.
+//   - kPreserve: leaves them as they were in the destination buffer; they may
+//     still be read and written back (fields closer than a word apart are
+//     blended in with masked word stores).
+//   - kSkip: never reads or writes them, e.g. for buffers another agent owns
+//     the padding of. serialize_with_checksum rejects it: the checksum
+//     covers the padding.
+// kPreserve and kSkip never copy the source's padding, even between identical
+// layouts.
+using PaddingPolicy = litte_pp::impl::PaddingPolicy;
+
+// Violate the google style guide in favor of std library convention.
+// NOLINTBEGIN(readability-identifier-naming)
+template <typename SerializableClassType, typename DataModelType>
+constexpr std::size_t serializable_class_size_v =
+    litte_pp::impl::Layout<SerializableClassType, DataModelType>::kSize;
+
+template <typename SerializableClassType, typename DataModelTypeA,
+          typename DataModelTypeB>
+constexpr bool is_layout_identical_v =
+    litte_pp::impl::LayoutIdentical<SerializableClassType, DataModelTypeA,
+                                    DataModelTypeB>::kValue;
+
+// Whether DataModelType describes the compiler's layout of the class, as far
+// as sizes and alignments (of the class and of every nested class) show.
+template <typename SerializableClassType, typename DataModelType>
+constexpr bool is_native_layout_v =
+    litte_pp::impl::NativeLayoutMatches<SerializableClassType,
+                                        DataModelType>::kValue;
+// NOLINTEND(readability-identifier-naming)
+
+// Whether every field of a SerializableClassType object, nested ones included,
+// is at the offset DataModelType gives it. Complements is_native_layout_v,
+// e.g. in a unit test or at startup:
+//
+//   static_assert(is_native_layout_v<Frame, NativeDataModel>, "");
+//   assert((has_native_field_offsets<Frame, NativeDataModel>()));
+template <typename SerializableClassType, typename DataModelType>
+inline auto has_native_field_offsets() -> bool {
+  return litte_pp::impl::has_native_field_offsets<SerializableClassType,
+                                                  DataModelType>();
+}
+
+// Converts an instance laid out in SrcDataModelType (`src`) into
+// DstDataModelType (`dst`). `src` and `dst` must not overlap and must span
+// serializable_class_size_v of their respective data model. Destination
+// padding bytes are handled per kPaddingPolicy; under kZero they are zeroed,
+// unless the layouts are identical (is_layout_identical_v) in which case `src`
+// is copied with a single memcpy, padding bytes included.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType,
+          PaddingPolicy kPaddingPolicy = PaddingPolicy::kZero>
+inline void convert(const unsigned char* src, unsigned char* dst) {
+  litte_pp::impl::CopyPlan<SerializableClassType, SrcDataModelType,
+                           DstDataModelType, kPaddingPolicy>::apply(src, dst);
+}
+
+// Converts `count` consecutive instances laid out in SrcDataModelType into
+// DstDataModelType. Records are strided by serializable_class_size_v of each
+// data model. Classes whose conversion is a pure byte permutation use
+// SSSE3/AVX2 shuffles when the CPU supports them (under kZero only).
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType,
+          PaddingPolicy kPaddingPolicy = PaddingPolicy::kZero>
+inline void convert_n(const unsigned char* src, unsigned char* dst,
+                      std::size_t count) {
+  litte_pp::impl::BatchConversion<SerializableClassType, SrcDataModelType,
+                                  DstDataModelType,
+                                  kPaddingPolicy>::convert(src, dst, count);
+}
+
+// Serializes `object` into `dst` laid out in DstDataModelType.
+// SrcDataModelType must describe how this architecture lays out the class
+// (e.g. NativeDataModel); see is_native_layout_v.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType,
+          PaddingPolicy kPaddingPolicy = PaddingPolicy::kZero>
+inline void serialize(const SerializableClassType& object, unsigned char* dst) {
+  static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                "Serialized class type must be trivially copyable.");
+  static_assert(
+      is_native_layout_v<SerializableClassType, SrcDataModelType>,
+      "SrcDataModelType does not describe this architecture's layout of "
+      "the class.");
+  convert<SerializableClassType, SrcDataModelType, DstDataModelType,
+          kPaddingPolicy>(
+      reinterpret_cast<const unsigned char*>(&object), dst);
+}
+
+// Deserializes `src` laid out in SrcDataModelType into `object`.
+// DstDataModelType must describe how this architecture lays out the class
+// (e.g. NativeDataModel); see is_native_layout_v.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType,
+          PaddingPolicy kPaddingPolicy = PaddingPolicy::kZero>
+inline void deserialize(const unsigned char* src,
+                        SerializableClassType& object) {
+  static_assert(std::is_trivially_copyable<SerializableClassType>::value,
+                "Deserialized class type must be trivially copyable.");
+  static_assert(
+      is_native_layout_v<SerializableClassType, DstDataModelType>,
+      "DstDataModelType does not describe this architecture's layout of "
+      "the class.");
+  convert<SerializableClassType, SrcDataModelType, DstDataModelType,
+          kPaddingPolicy>(
+      src, reinterpret_cast<unsigned char*>(&object));
+}
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_SERIALIZATION_H
@@ -0,0 +1,41 @@
+// ABOUT: The public API for LittlePP's in-place field access
+#ifndef LITTLE_PP_SERIALIZED_VIEW_H
+#define LITTLE_PP_SERIALIZED_VIEW_H
+
+#include "impl/serialized_view.h"
+
+namespace little_pp {
+namespace serialization {
+
+// A read-only view of a class serialized in DataModelType. get<I>() reads the
+// I-th field (in declaration order) and returns it as the native field type:
+//
+//   SerializedView<StatusBlock, DeviceModel> status(register_image);
+//   if (status.get<kErrorFlagsField>() != 0) { ... }
+//
+// A class member's get<I>() returns a view of the member, so nested fields are
+// reached by chaining: `status.get<kLinkField>().get<kSpeedField>()`.
+//
+// Fields are addressed by index because C++14 reflection (Boost::pfr) cannot
+// recover member names.
+template <typename SerializableClassType, typename DataModelType>
+using SerializedView =
+    litte_pp::impl::SerializedView<SerializableClassType, DataModelType>;
+
+// A writable view; set<I>() converts one native field value into the
+// serialized layout in place:
+//
+//   SerializedRef<ControlBlock, DeviceModel> control(shadow_image);
+//   control.set<kEnableField>(true);
+//
+// Pass `volatile unsigned char` as ByteType for memory-mapped images.
+template <typename SerializableClassType, typename DataModelType,
+          typename ByteType = unsigned char>
+using SerializedRef =
+    litte_pp::impl::SerializedRef<SerializableClassType, DataModelType,
+                                  ByteType>;
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_SERIALIZED_VIEW_H
@@ -0,0 +1,36 @@
+// ABOUT: The public API for LittlePP's shadow registers
+#ifndef LITTLE_PP_SHADOW_REGISTERS_H
+#define LITTLE_PP_SHADOW_REGISTERS_H
+
+#include "impl/shadow_registers.h"
+
+namespace little_pp {
+namespace serialization {
+
+// Bus constraints for ShadowRegisters::plan() and sync().
+using RegisterWriteOptions = litte_pp::impl::RegisterWriteOptions;
+using WriteTransaction = litte_pp::impl::WriteTransaction;
+
+// A native copy of a register block laid out in DeviceDataModelType. Fields
+// that set<I>() changes are written back with as few bus transactions as the
+// options allow:
+//
+//   ShadowRegisters<CoprocessorRegisters, NativeDataModel, CoprocessorModel>
+//       registers({}, {/*merge_gap=*/8, /*max_burst=*/32,
+//                      /*access_width=*/4});
+//   registers.set<kThreshold>(42);
+//   registers.set<kIrqMask>(0x3);
+//   registers.sync([&](std::size_t offset, const unsigned char* bytes,
+//                      std::size_t size) { spi_write(offset, bytes, size); });
+//
+// Every field starts dirty, so the first sync() writes the whole block.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DeviceDataModelType>
+using ShadowRegisters =
+    litte_pp::impl::ShadowRegisters<SerializableClassType, SrcDataModelType,
+                                    DeviceDataModelType>;
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_SHADOW_REGISTERS_H
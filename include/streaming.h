@@ -0,0 +1,54 @@
+// ABOUT: The public API for LittlePP's streaming (chunked) serialization and
+//        deserialization
+#ifndef LITTLE_PP_STREAMING_H
+#define LITTLE_PP_STREAMING_H
+
+#include "impl/streaming.h"
+
+namespace little_pp {
+namespace serialization {
+
+// Serializes an object a chunk at a time:
+//
+//   ChunkedSerializer<Frame, NativeModel, WireModel> serializer(frame);
+//   while (!serializer.is_done()) {
+//     const std::size_t size = serializer.write(dma_buffer, kDmaBufferSize);
+//     send(dma_buffer, size);
+//   }
+//
+// Each write() resumes exactly where the previous one stopped, so the
+// concatenated chunks equal serialize<...>()'s output.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+using ChunkedSerializer =
+    litte_pp::impl::ChunkedSerializer<SerializableClassType, SrcDataModelType,
+                                      DstDataModelType>;
+
+// Deserializes an object from fragments of any size, down to single bytes,
+// e.g. as a UART interrupt receives them:
+//
+//   ChunkedDeserializer<Frame, WireModel, NativeModel> deserializer(frame);
+//   void on_uart_byte(unsigned char byte) {
+//     if (deserializer.push(byte)) {
+//       handle(frame);
+//     }
+//   }
+//
+// push() restarts on its own after a completed object, so `frame` must be
+// handled (or copied) before the next byte is pushed.
+//
+// Each field is stored into the object as soon as its last byte arrives, so
+// the object is only consistent once is_done(). read() consumes a whole
+// fragment, stopping at the end of the object; whatever it did not consume
+// starts the next one. Serialized padding is skipped and the object's padding
+// is zeroed, like deserialize<...>().
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+using ChunkedDeserializer =
+    litte_pp::impl::ChunkedDeserializer<SerializableClassType,
+                                        SrcDataModelType, DstDataModelType>;
+
+}  // namespace serialization
+}  // namespace little_pp
+
+#endif  // LITTLE_PP_STREAMING_H
@@ -0,0 +1,88 @@
+// ABOUT: Bit fields are packed LSB-first into their storage word, and the
+//        layout engine converts that word like any other unsigned scalar.
+
+#include "include/bit_fields.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "include/padding_reflection.h"
+#include "include/serialization.h"
+#include "include/serialized_view.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+
+// mode: 3 bits, enable: 1 bit, reserved: 4 bits, divider: 8 bits
+using ControlBits = little_pp::BitFields<std::uint16_t, 3, 1, 4, 8>;
+
+struct ControlBlock {
+  std::uint8_t id;
+  ControlBits control;
+  std::uint32_t threshold;
+};
+
+template <typename SerializableClassType, typename DataModelType>
+using SerializedBuffer = std::array<
+    unsigned char, little_pp::serialization::serializable_class_size_v<
+                       SerializableClassType, DataModelType>>;
+
+TEST(BitFieldsTest, PacksFieldsLeastSignificantFirst) {
+  constexpr ControlBits kBits = ControlBits::pack(5, 1, 0, 0xA3);
+  static_assert(kBits.bits == 0xA30D, "");
+  static_assert(kBits.get<0>() == 5 && kBits.get<1>() == 1 &&
+                    kBits.get<2>() == 0 && kBits.get<3>() == 0xA3,
+                "");
+}
+
+TEST(BitFieldsTest, SetReplacesOnlyItsField) {
+  ControlBits bits = ControlBits::pack(5, 1, 0xF, 0xA3);
+  bits.set<1>(0);
+  bits.set<0>(0xFF);  // truncated to 3 bits
+
+  EXPECT_EQ(bits.get<0>(), 7);
+  EXPECT_EQ(bits.get<1>(), 0);
+  EXPECT_EQ(bits.get<2>(), 0xF);
+  EXPECT_EQ(bits.get<3>(), 0xA3);
+}
+
+TEST(BitFieldsTest, LaysOutAsStorageWord) {
+  static_assert(little_pp::serialization::is_native_layout_v<
+                    ControlBlock, Lp64LittleEndianDataModel>,
+                "");
+  constexpr auto kPaddingIndexes =
+      little_pp::padding_reflection::serializable_class_padding_indexes_v<
+          ControlBlock, Lp64BigEndianDataModel>;
+  static_assert(kPaddingIndexes.size() == 1 && kPaddingIndexes[0] == 1, "");
+}
+
+TEST(BitFieldsTest, SerializesWholeWordInDataModelByteOrder) {
+  const ControlBlock object{0x42, ControlBits::pack(5, 1, 0, 0xA3),
+                            0x01020304};
+  SerializedBuffer<ControlBlock, Lp64BigEndianDataModel> serialized{};
+  little_pp::serialization::serialize<ControlBlock, Lp64LittleEndianDataModel,
+                                      Lp64BigEndianDataModel>(
+      object, serialized.data());
+
+  const decltype(serialized) expected{0x42, 0x00, 0xA3, 0x0D,
+                                      0x01, 0x02, 0x03, 0x04};
+  EXPECT_EQ(serialized, expected);
+
+  const little_pp::serialization::SerializedView<ControlBlock,
+                                                 Lp64BigEndianDataModel>
+      view(serialized.data());
+  EXPECT_EQ(view.get<1>().get<3>(), 0xA3);
+
+  ControlBlock got{};
+  little_pp::serialization::deserialize<ControlBlock, Lp64BigEndianDataModel,
+                                        Lp64LittleEndianDataModel>(
+      serialized.data(), got);
+  EXPECT_EQ(got.control.bits, object.control.bits);
+}
+
+}  // namespace
@@ -0,0 +1,147 @@
+// ABOUT: Checksums computed during serialization must equal the checksum of
+//        the serialized bytes computed in a separate pass, and
+//        deserialization must reject any corrupted byte.
+
+#include "include/checksum.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "include/serialization.h"
+#include "lp64_little_endian_host.h"
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using little_pp::serialization::Crc16Ccitt;
+using little_pp::serialization::Crc32c;
+using little_pp::serialization::Fletcher16;
+using little_pp::serialization::PaddingPolicy;
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+
+// char@0 short@2 int@4 char@8, 3 bytes of trailing padding
+constexpr std::size_t kSerializedSize = 12;
+
+template <typename ChecksumType>
+auto checksum_of(const std::vector<unsigned char>& bytes) ->
+    typename ChecksumType::Value {
+  ChecksumType checksum;
+  checksum.update(bytes.data(), bytes.size());
+  return checksum.get_value();
+}
+
+auto to_bytes(const char* text) -> std::vector<unsigned char> {
+  std::vector<unsigned char> bytes;
+  for (; *text != '\0'; ++text) {
+    bytes.push_back(static_cast<unsigned char>(*text));
+  }
+  return bytes;
+}
+
+template <typename ChecksumType>
+void expect_zeros_folded_like_bytes() {
+  std::vector<unsigned char> bytes = to_bytes("header");
+  bytes.resize(bytes.size() + 300, 0);
+  ChecksumType checksum;
+  checksum.update(bytes.data(), 6);
+  checksum.update_zeros(300);
+  EXPECT_EQ(checksum.get_value(), checksum_of<ChecksumType>(bytes));
+}
+
+template <typename ChecksumType>
+void expect_serialized_checksum() {
+  const CharShortIntCharStruct object{'a', 0x0102, 0x03040506, 'b'};
+  std::vector<unsigned char> frame(
+      little_pp::serialization::checksummed_size_v<
+          ChecksumType, CharShortIntCharStruct, Lp64BigEndianDataModel>,
+      0xEE);
+  ASSERT_EQ(frame.size(), kSerializedSize + ChecksumType::kSize);
+  little_pp::serialization::serialize_with_checksum<
+      ChecksumType, CharShortIntCharStruct, Lp64LittleEndianDataModel,
+      Lp64BigEndianDataModel>(object, frame.data());
+
+  std::vector<unsigned char> serialized(kSerializedSize);
+  little_pp::serialization::serialize<CharShortIntCharStruct,
+                                      Lp64LittleEndianDataModel,
+                                      Lp64BigEndianDataModel>(
+      object, serialized.data());
+  EXPECT_EQ(std::vector<unsigned char>(frame.begin(),
+                                       frame.begin() + kSerializedSize),
+            serialized);
+
+  // big-endian, like the serialized fields
+  std::uint64_t stored = 0;
+  for (std::size_t i = kSerializedSize; i < frame.size(); ++i) {
+    stored = (stored << 8) | frame[i];
+  }
+  EXPECT_EQ(stored, checksum_of<ChecksumType>(serialized));
+}
+
+TEST(ChecksumTest, MatchesTheCheckValues) {
+  const std::vector<unsigned char> check = to_bytes("123456789");
+  EXPECT_EQ(checksum_of<Crc32c>(check), 0xE3069283U);
+  EXPECT_EQ(checksum_of<Crc16Ccitt>(check), 0x29B1U);
+  EXPECT_EQ(checksum_of<Fletcher16>(to_bytes("abcde")), 0xC8F0U);
+
+  expect_zeros_folded_like_bytes<Crc32c>();
+  expect_zeros_folded_like_bytes<Crc16Ccitt>();
+  expect_zeros_folded_like_bytes<Fletcher16>();
+}
+
+TEST(ChecksumTest, AppendsTheChecksumOfTheSerializedBytes) {
+  expect_serialized_checksum<Crc32c>();
+  expect_serialized_checksum<Crc16Ccitt>();
+  expect_serialized_checksum<Fletcher16>();
+}
+
+TEST(ChecksumTest, SumsPreservedPaddingAsTheBufferHoldsIt) {
+  const CharShortIntCharStruct object{'a', 0x0102, 0x03040506, 'b'};
+  std::vector<unsigned char> frame(kSerializedSize + Crc32c::kSize, 0xAA);
+  little_pp::serialization::serialize_with_checksum<
+      Crc32c, CharShortIntCharStruct, Lp64LittleEndianDataModel,
+      Lp64BigEndianDataModel, PaddingPolicy::kPreserve>(object, frame.data());
+  EXPECT_EQ(frame[1], 0xAA);
+  EXPECT_EQ(frame[kSerializedSize - 1], 0xAA);
+
+  const std::vector<unsigned char> serialized(frame.begin(),
+                                              frame.begin() + kSerializedSize);
+  const std::uint32_t stored = (std::uint32_t{frame[12]} << 24) |
+                               (std::uint32_t{frame[13]} << 16) |
+                               (std::uint32_t{frame[14]} << 8) | frame[15];
+  EXPECT_EQ(stored, checksum_of<Crc32c>(serialized));
+}
+
+TEST(ChecksumTest, RejectsAnyCorruptedByte) {
+  const CharShortIntCharStruct object{'a', 0x0102, 0x03040506, 'b'};
+  std::vector<unsigned char> frame(kSerializedSize + Crc16Ccitt::kSize);
+  little_pp::serialization::serialize_with_checksum<
+      Crc16Ccitt, CharShortIntCharStruct, Lp64LittleEndianDataModel,
+      Lp64BigEndianDataModel>(object, frame.data());
+
+  CharShortIntCharStruct got{};
+  ASSERT_TRUE((little_pp::serialization::deserialize_with_checksum<
+               Crc16Ccitt, CharShortIntCharStruct, Lp64BigEndianDataModel,
+               Lp64LittleEndianDataModel>(frame.data(), got)));
+  EXPECT_EQ(got.bar, object.bar);
+  EXPECT_EQ(got.foo, object.foo);
+  EXPECT_EQ(got.baz, object.baz);
+  EXPECT_EQ(got.buzz, object.buzz);
+
+  // fields, padding and the checksum itself
+  for (std::size_t i = 0; i < frame.size(); ++i) {
+    std::vector<unsigned char> corrupted = frame;
+    corrupted[i] ^= 0x10;
+    EXPECT_FALSE((little_pp::serialization::deserialize_with_checksum<
+                  Crc16Ccitt, CharShortIntCharStruct, Lp64BigEndianDataModel,
+                  Lp64LittleEndianDataModel>(corrupted.data(), got)))
+        << "byte " << i;
+  }
+}
+
+}  // namespace
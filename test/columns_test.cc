@@ -0,0 +1,179 @@
+// ABOUT: Column deserialization must produce, column by column, exactly what
+//        deserializing every record would.
+
+#include "include/columns.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "include/serialization.h"
+#include "lp64_little_endian_host.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/expected_data_nested_struct.h"
+#include "test_data/expected_data_std_array_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Ilp32BigEndianDataModel;
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_nested::CharIntCharCharStruct;
+using test_data::struct_std_array::CharShortArrayStructArrayStruct;
+
+struct BoolIntStruct {
+  bool ok;
+  int v;
+};
+
+// More records than one conversion block holds.
+constexpr std::size_t kRecordCount = 3000;
+
+template <typename SerializableClassType, typename SrcDataModelType>
+auto serialize_records(const std::vector<SerializableClassType>& records)
+    -> std::vector<unsigned char> {
+  constexpr std::size_t kSize =
+      little_pp::serialization::serializable_class_size_v<SerializableClassType,
+                                                          SrcDataModelType>;
+  std::vector<unsigned char> bytes(records.size() * kSize);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    little_pp::serialization::serialize<SerializableClassType,
+                                        Lp64LittleEndianDataModel,
+                                        SrcDataModelType>(
+        records[i], bytes.data() + i * kSize);
+  }
+  return bytes;
+}
+
+TEST(ColumnsTest, ConvertsWidthAndByteOrderIntoColumns) {
+  std::vector<CharIntLongStruct> records(kRecordCount);
+  for (std::size_t i = 0; i < kRecordCount; ++i) {
+    records[i] = CharIntLongStruct{static_cast<char>(i),
+                                   -static_cast<int>(i),
+                                   // fits the 4-byte long of ILP32
+                                   static_cast<long>(i) * 1000};  // NOLINT
+  }
+  const std::vector<unsigned char> bytes =
+      serialize_records<CharIntLongStruct, Ilp32BigEndianDataModel>(records);
+
+  little_pp::serialization::SoA<CharIntLongStruct> columns;
+  little_pp::serialization::deserialize_columns<
+      CharIntLongStruct, Ilp32BigEndianDataModel, Lp64LittleEndianDataModel>(
+      bytes.data(), kRecordCount, columns);
+
+  ASSERT_EQ(columns.size(), kRecordCount);
+  for (std::size_t i = 0; i < kRecordCount; ++i) {
+    EXPECT_EQ(columns.get<0>()[i], records[i].foo);
+    EXPECT_EQ(columns.get<1>()[i], records[i].bar);
+    EXPECT_EQ(columns.get<2>()[i], records[i].buzz);
+  }
+}
+
+TEST(ColumnsTest, FillsCallerOwnedNestedColumns) {
+  std::vector<CharIntCharCharStruct> records(kRecordCount);
+  for (std::size_t i = 0; i < kRecordCount; ++i) {
+    records[i] = CharIntCharCharStruct{
+        'a', {static_cast<int>(i * 3), 'i'}, static_cast<char>(i)};
+  }
+  const std::vector<unsigned char> bytes =
+      serialize_records<CharIntCharCharStruct, Lp64BigEndianDataModel>(
+          records);
+
+  std::vector<char> a(kRecordCount);
+  std::vector<test_data::struct_nested::IntChar> inner(kRecordCount);
+  std::vector<char> b(kRecordCount);
+  little_pp::serialization::deserialize_columns<
+      CharIntCharCharStruct, Lp64BigEndianDataModel,
+      Lp64LittleEndianDataModel>(
+      bytes.data(), kRecordCount,
+      little_pp::serialization::ColumnPointers<CharIntCharCharStruct>{
+          a.data(), inner.data(), b.data()});
+
+  for (std::size_t i = 0; i < kRecordCount; ++i) {
+    EXPECT_EQ(a[i], records[i].a);
+    EXPECT_EQ(inner[i].x, records[i].inner.x);
+    EXPECT_EQ(inner[i].y, records[i].inner.y);
+    EXPECT_EQ(b[i], records[i].b);
+  }
+}
+
+TEST(ColumnsTest, ConvertsArrayMembersElementwise) {
+  std::vector<CharShortArrayStructArrayStruct> records(10);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    const auto n = static_cast<short>(i);  // NOLINT(google-runtime-int)
+    records[i] = CharShortArrayStructArrayStruct{
+        't',
+        {{n, static_cast<short>(n + 1), -1}},
+        {{{1000 + n, 'x'}, {-n, 'y'}}}};
+  }
+  const std::vector<unsigned char> bytes =
+      serialize_records<CharShortArrayStructArrayStruct,
+                        Lp64BigEndianDataModel>(records);
+
+  little_pp::serialization::SoA<CharShortArrayStructArrayStruct> columns;
+  little_pp::serialization::deserialize_columns<
+      CharShortArrayStructArrayStruct, Lp64BigEndianDataModel,
+      Lp64LittleEndianDataModel>(bytes.data(), records.size(), columns);
+
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(columns.get<0>()[i], records[i].tag);
+    EXPECT_EQ(columns.get<1>()[i], records[i].samples);
+    EXPECT_EQ(columns.get<2>()[i][0].x, records[i].items[0].x);
+    EXPECT_EQ(columns.get<2>()[i][1].x, records[i].items[1].x);
+    EXPECT_EQ(columns.get<2>()[i][1].y, records[i].items[1].y);
+  }
+}
+
+TEST(ColumnsTest, StoresBoolFieldsContiguously) {
+  std::vector<BoolIntStruct> records(kRecordCount);
+  for (std::size_t i = 0; i < kRecordCount; ++i) {
+    records[i] = BoolIntStruct{i % 3 == 0, static_cast<int>(i)};
+  }
+  const std::vector<unsigned char> bytes =
+      serialize_records<BoolIntStruct, Lp64BigEndianDataModel>(records);
+
+  little_pp::serialization::SoA<BoolIntStruct> columns;
+  little_pp::serialization::deserialize_columns<
+      BoolIntStruct, Lp64BigEndianDataModel, Lp64LittleEndianDataModel>(
+      bytes.data(), kRecordCount, columns);
+
+  const little_pp::serialization::BoolColumn& ok = columns.get<0>();
+  ASSERT_EQ(ok.size(), kRecordCount);
+  for (std::size_t i = 0; i < kRecordCount; ++i) {
+    EXPECT_EQ(ok[i], records[i].ok);
+    EXPECT_EQ(columns.get<1>()[i], records[i].v);
+  }
+
+  // resizing keeps the converted values
+  columns.resize(kRecordCount + 1);
+  const little_pp::serialization::BoolColumn& resized = columns.get<0>();
+  EXPECT_EQ(resized.data()[kRecordCount - 3], records[kRecordCount - 3].ok);
+  EXPECT_FALSE(resized[kRecordCount]);
+}
+
+TEST(ColumnsTest, MovedFromSoAIsEmpty) {
+  little_pp::serialization::SoA<BoolIntStruct> columns(3);
+  columns.get<0>()[1] = true;
+
+  little_pp::serialization::SoA<BoolIntStruct> moved(std::move(columns));
+  EXPECT_EQ(moved.size(), 3U);
+  EXPECT_TRUE(moved.get<0>()[1]);
+  EXPECT_EQ(columns.size(), 0U);  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(columns.get<0>().size(), 0U);
+
+  // the moved-from object is still usable
+  columns.resize(5);
+  EXPECT_EQ(columns.get<0>().size(), 5U);
+  EXPECT_FALSE(columns.get<0>()[4]);
+
+  moved = std::move(columns);
+  EXPECT_EQ(moved.size(), 5U);
+  EXPECT_EQ(columns.size(), 0U);  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(columns.get<0>().size(), 0U);
+}
+
+}  // namespace
@@ -0,0 +1,185 @@
+// ABOUT: Delta frames must carry exactly the changed fields, and decoding the
+//        frames must reproduce every encoded object.
+
+#include "include/delta.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "lp64_little_endian_host.h"
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/expected_data_nested_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+using test_data::struct_nested::CharIntCharCharStruct;
+
+using Encoder =
+    little_pp::serialization::DeltaEncoder<CharShortIntCharStruct,
+                                           Lp64LittleEndianDataModel,
+                                           Lp64BigEndianDataModel>;
+using Decoder =
+    little_pp::serialization::DeltaDecoder<CharShortIntCharStruct,
+                                           Lp64BigEndianDataModel,
+                                           Lp64LittleEndianDataModel>;
+
+constexpr unsigned char kKeyframe = 'K';
+constexpr unsigned char kDelta = 'D';
+
+// NOLINTBEGIN(google-runtime-int)
+// More fields than fit one bitmap byte.
+struct Sensors {
+  short a;
+  short b;
+  short c;
+  short d;
+  short e;
+  short f;
+  short g;
+  short h;
+  int i;
+  char j;
+};
+// NOLINTEND(google-runtime-int)
+
+void expect_equal(const CharShortIntCharStruct& got,
+                  const CharShortIntCharStruct& expected) {
+  EXPECT_EQ(got.bar, expected.bar);
+  EXPECT_EQ(got.foo, expected.foo);
+  EXPECT_EQ(got.baz, expected.baz);
+  EXPECT_EQ(got.buzz, expected.buzz);
+}
+
+TEST(DeltaTest, SendsOnlyChangedFields) {
+  Encoder encoder;
+  std::vector<unsigned char> frame(Encoder::kMaxFrameSize);
+  CharShortIntCharStruct object{'a', 0x0102, 0x03040506, 'b'};
+
+  ASSERT_EQ(encoder.encode(object, frame.data()), 1U + 12U);
+  EXPECT_EQ(frame[0], kKeyframe);
+
+  // nothing changed: the kind byte and an empty bitmap
+  ASSERT_EQ(encoder.encode(object, frame.data()), 2U);
+  EXPECT_EQ(frame[0], kDelta);
+  EXPECT_EQ(frame[1], 0x00);
+
+  object.baz = 0x0A0B0C0D;
+  ASSERT_EQ(encoder.encode(object, frame.data()), 2U + 4U);
+  EXPECT_EQ(frame[1], 0x04);
+  const std::vector<unsigned char> baz{0x0A, 0x0B, 0x0C, 0x0D};
+  EXPECT_EQ(std::vector<unsigned char>(frame.begin() + 2, frame.begin() + 6),
+            baz);
+}
+
+TEST(DeltaTest, IgnoresPaddingWhenLayoutsAreIdentical) {
+  little_pp::serialization::DeltaEncoder<CharIntCharCharStruct,
+                                         Lp64LittleEndianDataModel,
+                                         Lp64LittleEndianDataModel>
+      encoder;
+  std::vector<unsigned char> frame(1 + 1 + 16);
+  CharIntCharCharStruct object;
+  std::memset(&object, 0xFF, sizeof(object));
+  object.a = 'a';
+  object.inner = {0x01020304, 'x'};
+  object.b = 'b';
+
+  ASSERT_EQ(encoder.encode(object, frame.data()), 1U + 16U);
+  const std::vector<unsigned char> keyframe{
+      kKeyframe, 'a',  0x00, 0x00, 0x00, 0x04, 0x03, 0x02, 0x01,
+      'x',       0x00, 0x00, 0x00, 'b',  0x00, 0x00, 0x00};
+  EXPECT_EQ(std::vector<unsigned char>(frame.begin(), frame.begin() + 17),
+            keyframe);
+
+  // only the inner member's trailing padding changed
+  reinterpret_cast<unsigned char*>(&object)[9] = 0x5A;
+  ASSERT_EQ(encoder.encode(object, frame.data()), 2U);
+  EXPECT_EQ(frame[1], 0x00);
+}
+
+TEST(DeltaTest, DecodesWhatWasEncoded) {
+  using SensorEncoder =
+      little_pp::serialization::DeltaEncoder<Sensors,
+                                             Lp64LittleEndianDataModel,
+                                             Lp64BigEndianDataModel>;
+  using SensorDecoder =
+      little_pp::serialization::DeltaDecoder<Sensors, Lp64BigEndianDataModel,
+                                             Lp64LittleEndianDataModel>;
+  SensorEncoder encoder;
+  SensorDecoder decoder;
+  std::vector<unsigned char> frame(SensorEncoder::kMaxFrameSize);
+
+  Sensors sensors{1, 2, 3, 4, 5, 6, 7, 8, 9, 'x'};
+  for (int step = 0; step < 20; ++step) {
+    sensors.c = static_cast<short>(sensors.c + step % 3);  // NOLINT
+    if (step % 5 == 0) {
+      sensors.i += 1000;
+    }
+    const std::size_t size = encoder.encode(sensors, frame.data());
+    Sensors got{};
+    ASSERT_EQ(decoder.decode(frame.data(), size, got), size);
+    EXPECT_EQ(got.c, sensors.c);
+    EXPECT_EQ(got.h, sensors.h);
+    EXPECT_EQ(got.i, sensors.i);
+    EXPECT_EQ(got.j, sensors.j);
+  }
+}
+
+TEST(DeltaTest, SendsPeriodicAndRequestedKeyframes) {
+  Encoder encoder(3);
+  std::vector<unsigned char> frame(Encoder::kMaxFrameSize);
+  const CharShortIntCharStruct object{'a', 1, 2, 'b'};
+  std::vector<unsigned char> kinds;
+  for (int i = 0; i < 7; ++i) {
+    if (i == 5) {
+      encoder.request_keyframe();
+    }
+    encoder.encode(object, frame.data());
+    kinds.push_back(frame[0]);
+  }
+  const std::vector<unsigned char> expected{kKeyframe, kDelta, kDelta,
+                                            kKeyframe, kDelta, kKeyframe,
+                                            kDelta};
+  EXPECT_EQ(kinds, expected);
+}
+
+TEST(DeltaTest, RejectsFramesItCannotApply) {
+  Encoder encoder;
+  Decoder decoder;
+  std::vector<unsigned char> keyframe(Encoder::kMaxFrameSize);
+  std::vector<unsigned char> delta(Encoder::kMaxFrameSize);
+  CharShortIntCharStruct object{'a', 1, 2, 'b'};
+  const std::size_t keyframe_size = encoder.encode(object, keyframe.data());
+  object.foo = 3;
+  const std::size_t delta_size = encoder.encode(object, delta.data());
+
+  CharShortIntCharStruct got{'z', 0, 0, 'z'};
+  // not synchronized yet
+  EXPECT_EQ(decoder.decode(delta.data(), delta_size, got), 0U);
+  EXPECT_EQ(got.bar, 'z');
+  // truncated
+  EXPECT_EQ(decoder.decode(keyframe.data(), keyframe_size - 1, got), 0U);
+  EXPECT_FALSE(decoder.is_synchronized());
+
+  EXPECT_EQ(decoder.decode(keyframe.data(), keyframe_size, got),
+            keyframe_size);
+  EXPECT_EQ(decoder.decode(delta.data(), delta_size - 1, got), 0U);
+  // a bit for a field the class does not have
+  std::vector<unsigned char> stray = delta;
+  stray[1] |= 0x80;
+  EXPECT_EQ(decoder.decode(stray.data(), stray.size(), got), 0U);
+
+  EXPECT_EQ(decoder.decode(delta.data(), delta_size, got), delta_size);
+  expect_equal(got, object);
+
+  decoder.reset();
+  EXPECT_EQ(decoder.decode(delta.data(), delta_size, got), 0U);
+}
+
+}  // namespace
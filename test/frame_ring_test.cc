@@ -0,0 +1,117 @@
+// ABOUT: Frames pushed into a FrameRing must come out in order, converted or
+//        viewed in place, whether or not the ring wraps and whether or not the
+//        producer runs on another thread.
+
+#include "include/frame_ring.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "include/serialization.h"
+#include "lp64_little_endian_host.h"
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+
+template <std::size_t kCapacity>
+using Ring =
+    little_pp::serialization::FrameRing<CharShortIntCharStruct,
+                                        Lp64BigEndianDataModel, kCapacity,
+                                        Lp64LittleEndianDataModel>;
+
+constexpr std::size_t kFrameSize = 12;
+
+auto make_frame(int sequence) -> std::vector<unsigned char> {
+  const CharShortIntCharStruct object{'f', 7, sequence, 'e'};
+  std::vector<unsigned char> frame(kFrameSize);
+  little_pp::serialization::serialize<CharShortIntCharStruct,
+                                      Lp64LittleEndianDataModel,
+                                      Lp64BigEndianDataModel>(object,
+                                                              frame.data());
+  return frame;
+}
+
+TEST(FrameRingTest, SlotsHaveTheFrameSizeAndAlignment) {
+  static_assert(Ring<4>::kSlotSize == kFrameSize, "");
+  static_assert(Ring<4>::kSlotAlignment == 4, "");
+  Ring<4> ring;
+  for (int i = 0; i < 4; ++i) {
+    unsigned char* slot = ring.get_write_slot();
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(slot) % 4, 0U);
+    ring.commit_write();
+  }
+  EXPECT_EQ(ring.get_write_slot(), nullptr);
+}
+
+TEST(FrameRingTest, PopsInOrderAcrossWraparound) {
+  Ring<4> ring;
+  int pushed = 0;
+  int popped = 0;
+  for (int round = 0; round < 5; ++round) {
+    while (ring.try_push(make_frame(pushed).data())) {
+      pushed++;
+    }
+    EXPECT_EQ(ring.size(), 4U);
+    // leave one frame behind so the next round starts mid-ring
+    for (int i = 0; i < 3; ++i) {
+      CharShortIntCharStruct object{};
+      ASSERT_TRUE(ring.try_pop(object));
+      EXPECT_EQ(object.bar, 'f');
+      EXPECT_EQ(object.foo, 7);
+      EXPECT_EQ(object.baz, popped);
+      EXPECT_EQ(object.buzz, 'e');
+      popped++;
+    }
+  }
+  CharShortIntCharStruct object{};
+  EXPECT_TRUE(ring.try_pop(object));
+  EXPECT_FALSE(ring.try_pop(object));
+  EXPECT_TRUE(ring.is_empty());
+}
+
+TEST(FrameRingTest, ConsumesFramesInPlace) {
+  Ring<2> ring;
+  ASSERT_TRUE(ring.try_push(make_frame(0x01020304).data()));
+  int baz = 0;
+  EXPECT_TRUE(ring.try_consume(
+      [&baz](const Ring<2>::View& view) { baz = view.get<2>(); }));
+  EXPECT_EQ(baz, 0x01020304);
+  EXPECT_FALSE(ring.try_consume([](const Ring<2>::View& /*unused*/) {}));
+}
+
+TEST(FrameRingTest, HandsFramesBetweenThreads) {
+  constexpr int kFrameCount = 100000;
+  static Ring<64> ring;
+  std::thread producer([] {
+    for (int i = 0; i < kFrameCount; ++i) {
+      const std::vector<unsigned char> frame = make_frame(i);
+      while (!ring.try_push(frame.data())) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  int expected = 0;
+  while (expected < kFrameCount) {
+    CharShortIntCharStruct object{};
+    if (!ring.try_pop(object)) {
+      std::this_thread::yield();
+      continue;
+    }
+    EXPECT_EQ(object.baz, expected);
+    expected++;
+  }
+  producer.join();
+  EXPECT_TRUE(ring.is_empty());
+}
+
+}  // namespace
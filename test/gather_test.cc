@@ -0,0 +1,116 @@
+// ABOUT: Gather serialization must reproduce serialize()'s output when its
+//        iovecs are concatenated, while referencing the source object for
+//        every long enough run that needs no conversion.
+
+#include "include/gather.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "include/data_model.h"
+#include "include/serialization.h"
+#include "lp64_little_endian_host.h"
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+
+// NOLINTBEGIN(google-runtime-int)
+struct Telemetry {
+  char flags;
+  std::array<int, 16> samples;
+  short tail;
+};
+// NOLINTEND(google-runtime-int)
+
+auto concatenate(const iovec* iovecs, std::size_t count)
+    -> std::vector<unsigned char> {
+  std::vector<unsigned char> bytes;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto* base = static_cast<const unsigned char*>(iovecs[i].iov_base);
+    bytes.insert(bytes.end(), base, base + iovecs[i].iov_len);
+  }
+  return bytes;
+}
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+auto serialize_to_vector(const SerializableClassType& object)
+    -> std::vector<unsigned char> {
+  std::vector<unsigned char> bytes(
+      little_pp::serialization::serializable_class_size_v<SerializableClassType,
+                                                          DstDataModelType>);
+  little_pp::serialization::serialize<SerializableClassType, SrcDataModelType,
+                                      DstDataModelType>(object, bytes.data());
+  return bytes;
+}
+
+TEST(GatherTest, ReferencesRunsAlreadyInTargetLayout) {
+  using WireModel = little_pp::Packed<Lp64LittleEndianDataModel>;
+  using Gather = little_pp::serialization::GatherSerializer<
+      Telemetry, Lp64LittleEndianDataModel, WireModel>;
+  // `flags` is copied into the scratch area; `samples` and `tail` are
+  // contiguous in both layouts and referenced as one iovec.
+  static_assert(Gather::get_iovec_count() == 2, "");
+  static_assert(Gather::kScratchSize == 1, "");
+
+  Telemetry telemetry{};
+  telemetry.flags = 'f';
+  for (std::size_t i = 0; i < telemetry.samples.size(); ++i) {
+    telemetry.samples[i] = static_cast<int>(i * 0x01010101);
+  }
+  telemetry.tail = 0x1234;
+  const Gather gather(telemetry);
+
+  EXPECT_EQ(gather.get_iovecs()[1].iov_base,
+            static_cast<const void*>(&telemetry.samples));
+  EXPECT_EQ(
+      concatenate(gather.get_iovecs(), gather.get_iovec_count()),
+      (serialize_to_vector<Telemetry, Lp64LittleEndianDataModel, WireModel>(
+          telemetry)));
+}
+
+TEST(GatherTest, MergesNeighbouringScratchRuns) {
+  // every run is converted or padding, so the whole class is one iovec
+  using Gather = little_pp::serialization::GatherSerializer<
+      CharShortIntCharStruct, Lp64LittleEndianDataModel,
+      Lp64BigEndianDataModel>;
+  static_assert(Gather::get_iovec_count() == 1, "");
+
+  const CharShortIntCharStruct object{'a', 0x0102, 0x03040506, 'b'};
+  const Gather gather(object);
+  EXPECT_EQ(concatenate(gather.get_iovecs(), gather.get_iovec_count()),
+            (serialize_to_vector<CharShortIntCharStruct,
+                                 Lp64LittleEndianDataModel,
+                                 Lp64BigEndianDataModel>(object)));
+}
+
+TEST(GatherTest, ResetRetargetsTheSerializer) {
+  // with no minimum, even single-byte fields are referenced
+  using Gather = little_pp::serialization::GatherSerializer<
+      CharIntLongStruct, Lp64LittleEndianDataModel, Lp64BigEndianDataModel,
+      1>;
+  const CharIntLongStruct first{'x', 0x11223344, 0x0102030405060708};
+  const CharIntLongStruct second{'y', -2, -3};
+  Gather gather(first);
+  EXPECT_EQ(gather.get_iovecs()[0].iov_base,
+            static_cast<const void*>(&first.foo));
+
+  gather.reset(second);
+  EXPECT_EQ(gather.get_iovecs()[0].iov_base,
+            static_cast<const void*>(&second.foo));
+  EXPECT_EQ(concatenate(gather.get_iovecs(), gather.get_iovec_count()),
+            (serialize_to_vector<CharIntLongStruct, Lp64LittleEndianDataModel,
+                                 Lp64BigEndianDataModel>(second)));
+}
+
+}  // namespace
@@ -41,11 +41,14 @@
 #include <gtest/gtest.h>
 
 #include "std_array_comparison_operators.h"
+#include "test_data/expected_data_char_int_char_short_double_char_struct.h"
 #include "test_data/expected_data_char_short_int_char_struct.h"
 #include "test_data/expected_data_char_short_int_struct.h"
 #include "test_data/expected_data_empty_struct.h"
 #include "test_data/expected_data_int_char.h"
+#include "test_data/expected_data_nested_struct.h"
 #include "test_data/expected_data_short_uchar_char_uint_struct.h"
+#include "test_data/expected_data_std_array_struct.h"
 #include "test_data/interface_expected_data.h"
 
 #define UNCOMMENT_TO_FAIL_AND_PRINT ADD_FAILURE
@@ -81,6 +84,18 @@ using DataModelImplementations = testing::Types<
     test_data::struct_char_short_int_char::ExpectedData<
         test_data::data_models::Simple32BitDataModel>,
     test_data::struct_char_short_int_char::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_nested::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_nested::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_std_array::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_std_array::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_char_int_char_short_double_char::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_char_int_char_short_double_char::ExpectedData<
         test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>
     // clang-format off
 >;
@@ -136,7 +151,3 @@ TYPED_TEST(PaddingReflectionTest, ReturnsExpectedPaddingByteIndexes) {
 
   static_assert(kGot == kExpected, "Padding indexes did not match expected.");
 }
-
-// TODO:
-// - test array data members
-// - test nested struct/class
@@ -0,0 +1,19 @@
+#ifndef LP64_LITTLE_ENDIAN_HOST_H
+#define LP64_LITTLE_ENDIAN_HOST_H
+
+// Included by the tests that move bytes of native objects: they use
+// Lp64LittleEndianDataModel as the in-memory layout of the test structs, so
+// they only build on such hosts (the k8 toolchain). The compile-time padding
+// reflection tests, the benchmark and the tools do not include it.
+
+#include <type_traits>
+
+#include "include/data_model.h"
+#include "test_data/tested_data_models.h"
+
+static_assert(
+    std::is_same<little_pp::NativeDataModel,
+                 test_data::data_models::Lp64LittleEndianDataModel>::value,
+    "These tests assume an LP64 little-endian host.");
+
+#endif  // LP64_LITTLE_ENDIAN_HOST_H
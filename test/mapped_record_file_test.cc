@@ -0,0 +1,138 @@
+// ABOUT: A mapped record file must convert exactly the records serialize()
+//        wrote, through every access path (random access, iteration and
+//        batch decode).
+
+#include "include/mapped_record_file.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "include/serialization.h"
+#include "lp64_little_endian_host.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Ilp32BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+
+using LogFile =
+    little_pp::serialization::MappedRecordFile<CharIntLongStruct,
+                                               Ilp32BigEndianDataModel,
+                                               Lp64LittleEndianDataModel>;
+
+constexpr std::size_t kRecordCount = 100;
+
+auto make_record(std::size_t i) -> CharIntLongStruct {
+  return CharIntLongStruct{static_cast<char>('a' + i % 26),
+                           static_cast<int>(i) * -1000,
+                           static_cast<long>(i) * 100000};  // NOLINT
+}
+
+void expect_record(const CharIntLongStruct& got, std::size_t i) {
+  const CharIntLongStruct expected = make_record(i);
+  EXPECT_EQ(got.foo, expected.foo) << "record " << i;
+  EXPECT_EQ(got.bar, expected.bar) << "record " << i;
+  EXPECT_EQ(got.buzz, expected.buzz) << "record " << i;
+}
+
+class MappedRecordFileTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = testing::TempDir() + "mapped_record_file_test.bin";
+    std::vector<unsigned char> bytes(kRecordCount * LogFile::kRecordSize);
+    for (std::size_t i = 0; i < kRecordCount; ++i) {
+      little_pp::serialization::serialize<CharIntLongStruct,
+                                          Lp64LittleEndianDataModel,
+                                          Ilp32BigEndianDataModel>(
+          make_record(i), bytes.data() + i * LogFile::kRecordSize);
+    }
+    // a record cut off mid-write
+    bytes.insert(bytes.end(), {0x01, 0x02, 0x03});
+    write_file(bytes);
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  void write_file(const std::vector<unsigned char>& bytes) {
+    std::FILE* file = std::fopen(path_.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    if (!bytes.empty()) {
+      std::fwrite(bytes.data(), 1, bytes.size(), file);
+    }
+    std::fclose(file);
+  }
+
+  std::string path_;
+};
+
+TEST_F(MappedRecordFileTest, StridesByTheFileDataModelSize) {
+  static_assert(LogFile::kRecordSize == 12, "");
+  const LogFile file(path_);
+  EXPECT_EQ(file.size(), kRecordCount);
+  EXPECT_EQ(file.get_trailing_byte_count(), 3U);
+}
+
+TEST_F(MappedRecordFileTest, ConvertsRecordsOnRandomAccess) {
+  const LogFile file(path_);
+  expect_record(file[kRecordCount - 1], kRecordCount - 1);
+  expect_record(file[0], 0);
+  expect_record(file.at(42), 42);
+  EXPECT_THROW(file.at(kRecordCount), std::out_of_range);
+}
+
+TEST_F(MappedRecordFileTest, IteratesInOrder) {
+  static_assert(
+      std::is_same<std::iterator_traits<LogFile::Iterator>::iterator_category,
+                   std::input_iterator_tag>::value,
+      "");
+  const LogFile file(path_);
+  std::size_t i = 0;
+  for (const CharIntLongStruct record : file) {
+    expect_record(record, i);
+    i++;
+  }
+  EXPECT_EQ(i, kRecordCount);
+}
+
+TEST_F(MappedRecordFileTest, DecodesRanges) {
+  const LogFile file(path_);
+  std::vector<CharIntLongStruct> records(kRecordCount - 10);
+  file.decode(10, records.size(), records.data());
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    expect_record(records[i], i + 10);
+  }
+}
+
+TEST_F(MappedRecordFileTest, MovesTheMapping) {
+  LogFile file(path_);
+  LogFile moved(std::move(file));
+  EXPECT_EQ(moved.size(), kRecordCount);
+  EXPECT_TRUE(file.empty());  // NOLINT(bugprone-use-after-move)
+  expect_record(moved[1], 1);
+}
+
+TEST_F(MappedRecordFileTest, MapsEmptyFiles) {
+  write_file({});
+  const LogFile file(path_);
+  EXPECT_TRUE(file.empty());
+  EXPECT_TRUE(file.begin() == file.end());
+}
+
+TEST(MappedRecordFileErrorTest, ThrowsWhenTheFileCannotBeOpened) {
+  EXPECT_THROW(LogFile(testing::TempDir() + "does/not/exist.bin"),
+               std::system_error);
+}
+
+}  // namespace
@@ -0,0 +1,84 @@
+// ABOUT: NativeDataModel is derived from the compiler, so it must agree with
+//        the hand-written model of the (LP64 little-endian) test host, and the
+//        native-layout checks must accept every test struct under it while
+//        rejecting classes the compiler packs differently.
+
+#include "include/serialization.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "include/data_model.h"
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/expected_data_nested_struct.h"
+#include "test_data/expected_data_std_array_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using little_pp::NativeDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+using test_data::struct_nested::CharIntCharCharStruct;
+using test_data::struct_std_array::CharShortArrayStructArrayStruct;
+
+#pragma pack(push, 1)
+struct PackedCharInt {
+  char tag;
+  std::int32_t value;
+};
+#pragma pack(pop)
+
+struct OverAlignedMember {
+  char tag;
+  alignas(8) std::int32_t value;
+};
+
+TEST(NativeLayoutTest, NativeDataModelMatchesHostDataModel) {
+  static_assert(
+      NativeDataModel::get_size<long>() ==
+              Lp64LittleEndianDataModel::get_size<long>() &&
+          NativeDataModel::get_alignment<double>() ==
+              Lp64LittleEndianDataModel::get_alignment<double>() &&
+          NativeDataModel::get_endianess() ==
+              Lp64LittleEndianDataModel::get_endianess(),
+      "");
+  static_assert(little_pp::serialization::is_layout_identical_v<
+                    CharIntLongStruct, NativeDataModel,
+                    Lp64LittleEndianDataModel>,
+                "");
+}
+
+TEST(NativeLayoutTest, AcceptsCompilerLayouts) {
+  static_assert(little_pp::serialization::is_native_layout_v<
+                    CharShortIntCharStruct, NativeDataModel>,
+                "");
+  static_assert(little_pp::serialization::is_native_layout_v<
+                    CharIntCharCharStruct, NativeDataModel>,
+                "");
+  static_assert(little_pp::serialization::is_native_layout_v<
+                    CharShortArrayStructArrayStruct, NativeDataModel>,
+                "");
+
+  EXPECT_TRUE((little_pp::serialization::has_native_field_offsets<
+               CharIntCharCharStruct, NativeDataModel>()));
+  EXPECT_TRUE((little_pp::serialization::has_native_field_offsets<
+               CharShortArrayStructArrayStruct, NativeDataModel>()));
+}
+
+TEST(NativeLayoutTest, RejectsRepackedAndRealignedClasses) {
+  static_assert(!little_pp::serialization::is_native_layout_v<PackedCharInt,
+                                                               NativeDataModel>,
+                "");
+  static_assert(!little_pp::serialization::is_native_layout_v<
+                    OverAlignedMember, NativeDataModel>,
+                "");
+
+  EXPECT_FALSE((little_pp::serialization::has_native_field_offsets<
+                OverAlignedMember, NativeDataModel>()));
+}
+
+}  // namespace
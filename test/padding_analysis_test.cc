@@ -0,0 +1,227 @@
+// ABOUT: Padding reports and optimal field orders are compile-time values, so
+//        most checks are static_asserts (see little_pp_test.cc for why); the
+//        JSON writer runs at runtime and is checked with gtest assertions.
+
+#include "include/padding_reflection.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <sstream>
+
+#include "include/padding_report.h"
+#include "std_array_comparison_operators.h"
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/expected_data_empty_struct.h"
+#include "test_data/expected_data_nested_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using little_pp::padding_reflection::PaddingReport;
+using little_pp::padding_reflection::serializable_class_optimal_field_order_v;
+using little_pp::padding_reflection::serializable_class_padding_report_v;
+using test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel;
+using test_data::data_models::Simple32BitDataModel;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+using test_data::struct_empty::Empty;
+using test_data::struct_nested::CharIntCharCharStruct;
+
+// Simple32BitDataModel, except that ints are 5 bytes with an alignment of 4:
+// sorting by alignment no longer removes all padding.
+// clang-format off
+// NOLINTBEGIN(*-magic-numbers)
+using OddIntDataModel =
+    little_pp::DataModel<1, 1, 1, 1, 1, 1, 2, 2,
+
+                         2, 2, 2, 2,
+
+                         5, 4, 5, 4,
+
+                         8, 8, 8, 8,
+
+                         8, 8, 8, 8,
+
+                         4, 4, 8, 8, 8, 8,
+
+                         1, 1>;
+// NOLINTEND(*-magic-numbers)
+// clang-format on
+
+// Simple32BitDataModel, except that shorts are 3 bytes with an alignment of 2.
+// clang-format off
+// NOLINTBEGIN(*-magic-numbers)
+using OddShortDataModel =
+    little_pp::DataModel<1, 1, 1, 1, 1, 1, 2, 2,
+
+                         3, 2, 3, 2,
+
+                         4, 4, 4, 4,
+
+                         8, 8, 8, 8,
+
+                         8, 8, 8, 8,
+
+                         4, 4, 8, 8, 8, 8,
+
+                         1, 1>;
+// NOLINTEND(*-magic-numbers)
+// clang-format on
+
+struct IntIntShortCharStruct {
+  int a;
+  int b;
+  short c;  // NOLINT(google-runtime-int)
+  char d;
+};
+
+// kMaxExhaustiveFieldCount members
+struct CharShortCharShortCharShortIntStruct {
+  char a;
+  short b;  // NOLINT(google-runtime-int)
+  char c;
+  short d;  // NOLINT(google-runtime-int)
+  char e;
+  short f;  // NOLINT(google-runtime-int)
+  int g;
+};
+
+struct IntIntShortSixCharStruct {
+  int a;
+  int b;
+  short c;  // NOLINT(google-runtime-int)
+  char d;
+  char e;
+  char f;
+  char g;
+  char h;
+  char i;
+};
+
+TEST(PaddingAnalysisTest, SortsByAlignment) {
+  constexpr PaddingReport kReport =
+      serializable_class_padding_report_v<CharShortIntCharStruct,
+                                          Simple32BitDataModel>;
+  static_assert(kReport.size == 12, "");
+  static_assert(kReport.padding_byte_count == 4, "");
+  static_assert(kReport.optimal_size == 8, "");
+  static_assert(kReport.optimal_padding_byte_count == 0, "");
+  static_assert(kReport.is_optimal_order_exact, "");
+  static_assert(serializable_class_optimal_field_order_v<
+                    CharShortIntCharStruct, Simple32BitDataModel> ==
+                    std::array<std::size_t, 4>{{2, 1, 0, 3}},
+                "");
+  EXPECT_DOUBLE_EQ(kReport.padding_ratio, 4.0 / 12.0);
+}
+
+TEST(PaddingAnalysisTest, KeepsPaddingInsideNestedMembers) {
+  constexpr PaddingReport kReport =
+      serializable_class_padding_report_v<CharIntCharCharStruct,
+                                          Simple32BitDataModel>;
+  static_assert(kReport.size == 16, "");
+  static_assert(kReport.padding_byte_count == 9, "");
+  // the inner struct's 3 bytes of trailing padding remain
+  static_assert(kReport.optimal_size == 12, "");
+  static_assert(kReport.optimal_padding_byte_count == 5, "");
+  static_assert(serializable_class_optimal_field_order_v<
+                    CharIntCharCharStruct, Simple32BitDataModel> ==
+                    std::array<std::size_t, 3>{{1, 0, 2}},
+                "");
+}
+
+TEST(PaddingAnalysisTest, ReportsEmptyClasses) {
+  constexpr PaddingReport kReport =
+      serializable_class_padding_report_v<Empty, Simple32BitDataModel>;
+  static_assert(kReport.size == 0, "");
+  static_assert(kReport.optimal_size == 0, "");
+  static_assert(kReport.is_optimal_order_exact, "");
+  EXPECT_EQ(kReport.padding_ratio, 0.0);
+}
+
+TEST(PaddingAnalysisTest, SearchesEveryOrderWhenSortingIsNotEnough) {
+  constexpr PaddingReport kReport =
+      serializable_class_padding_report_v<IntIntShortCharStruct,
+                                          OddIntDataModel>;
+  // sorted: a@0, b@8, c@14, d@16, 3 bytes of trailing padding
+  static_assert(kReport.size == 20, "");
+  // the char fills the hole after b instead
+  static_assert(kReport.optimal_size == 16, "");
+  static_assert(kReport.is_optimal_order_exact, "");
+  static_assert(serializable_class_optimal_field_order_v<
+                    IntIntShortCharStruct, OddIntDataModel> ==
+                    std::array<std::size_t, 4>{{0, 1, 3, 2}},
+                "");
+}
+
+TEST(PaddingAnalysisTest, SearchesEveryOrderOfTheLargestExhaustiveClass) {
+  static_assert(boost::pfr::tuple_size_v<
+                    CharShortCharShortCharShortIntStruct> ==
+                    litte_pp::impl::kMaxExhaustiveFieldCount,
+                "");
+  constexpr PaddingReport kReport =
+      serializable_class_padding_report_v<CharShortCharShortCharShortIntStruct,
+                                          OddShortDataModel>;
+  static_assert(kReport.size == 20, "");
+  // sorted: g@0, the shorts at 4, 8 and 12, the chars from 15: also 20 bytes
+  static_assert(kReport.optimal_size == 16, "");
+  static_assert(kReport.optimal_padding_byte_count == 0, "");
+  static_assert(kReport.is_optimal_order_exact, "");
+  // each char fills the byte after a short
+  static_assert(serializable_class_optimal_field_order_v<
+                    CharShortCharShortCharShortIntStruct, OddShortDataModel> ==
+                    std::array<std::size_t, 7>{{1, 0, 3, 2, 5, 4, 6}},
+                "");
+}
+
+TEST(PaddingAnalysisTest, FlagsInexactOrdersOfLargeClasses) {
+  constexpr PaddingReport kReport =
+      serializable_class_padding_report_v<IntIntShortSixCharStruct,
+                                          OddIntDataModel>;
+  static_assert(kReport.optimal_size == 24, "");
+  static_assert(!kReport.is_optimal_order_exact, "");
+}
+
+TEST(PaddingAnalysisTest, WritesJson) {
+  std::ostringstream out;
+  little_pp::padding_reflection::write_padding_report_json<
+      CharShortIntCharStruct, Simple32BitDataModel,
+      Simple32BitButIntsNotSelfAlignedDataModel>(
+      out, "CharShortIntChar\"Struct", {{"simple_32_bit", "ints\\2"}});
+  EXPECT_EQ(out.str(),
+            "{\"class\":\"CharShortIntChar\\\"Struct\",\"field_count\":4,"
+            "\"data_models\":["
+            "{\"name\":\"simple_32_bit\",\"size\":12,\"padding_bytes\":4,"
+            "\"padding_ratio\":0.333333,\"optimal_size\":8,"
+            "\"optimal_padding_bytes\":0,\"optimal_field_order\":[2,1,0,3],"
+            "\"optimal_order_exact\":true},"
+            "{\"name\":\"ints\\\\2\",\"size\":10,\"padding_bytes\":2,"
+            "\"padding_ratio\":0.2,\"optimal_size\":8,"
+            "\"optimal_padding_bytes\":0,\"optimal_field_order\":[1,2,0,3],"
+            "\"optimal_order_exact\":true}]}");
+}
+
+TEST(PaddingAnalysisTest, WritesOneJsonArrayForManyClasses) {
+  using DataModels =
+      little_pp::padding_reflection::DataModels<Simple32BitDataModel,
+                                                OddIntDataModel>;
+  const std::array<const char*, 2> data_model_names{{"simple", "odd"}};
+  std::ostringstream expected;
+  expected << "[\n";
+  little_pp::padding_reflection::write_padding_report_json<
+      Empty, Simple32BitDataModel, OddIntDataModel>(expected, "Empty",
+                                                    data_model_names);
+  expected << ",\n";
+  little_pp::padding_reflection::write_padding_report_json<
+      CharIntCharCharStruct, Simple32BitDataModel, OddIntDataModel>(
+      expected, "Nested", data_model_names);
+  expected << "\n]";
+
+  std::ostringstream out;
+  little_pp::padding_reflection::write_padding_reports_json<
+      DataModels, Empty, CharIntCharCharStruct>(out, {{"Empty", "Nested"}},
+                                                data_model_names);
+  EXPECT_EQ(out.str(), expected.str());
+}
+
+}  // namespace
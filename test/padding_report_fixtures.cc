@@ -0,0 +1,47 @@
+// ABOUT: Prints the JSON padding report (see include/padding_report.h) of the
+//        test structs under the test data models, as an example of a report
+//        over many classes. Run with
+//        `bazelisk run //test:padding_report_fixtures`.
+
+#include "include/padding_report.h"
+
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/expected_data_empty_struct.h"
+#include "test_data/expected_data_int_char.h"
+#include "test_data/expected_data_nested_struct.h"
+#include "test_data/expected_data_short_uchar_char_uint_struct.h"
+#include "test_data/expected_data_std_array_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Ilp32BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel;
+using test_data::data_models::Simple32BitDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+using test_data::struct_empty::Empty;
+using test_data::struct_int_char::IntCharStruct;
+using test_data::struct_nested::CharIntCharCharStruct;
+using test_data::struct_short_uchar_char_uint::ShortUCharCharIntStruct;
+using test_data::struct_std_array::CharShortArrayStructArrayStruct;
+
+}  // namespace
+
+auto main() -> int {
+  using little_pp::padding_reflection::DataModels;
+  return little_pp::padding_reflection::padding_report_main<
+      DataModels<Simple32BitDataModel,
+                 Simple32BitButIntsNotSelfAlignedDataModel,
+                 Lp64LittleEndianDataModel, Ilp32BigEndianDataModel>,
+      Empty, IntCharStruct, CharIntLongStruct, CharShortIntCharStruct,
+      ShortUCharCharIntStruct, CharIntCharCharStruct,
+      CharShortArrayStructArrayStruct>(
+      {{"Empty", "IntCharStruct", "CharIntLongStruct", "CharShortIntCharStruct",
+        "ShortUCharCharIntStruct", "CharIntCharCharStruct",
+        "CharShortArrayStructArrayStruct"}},
+      {{"simple_32_bit", "simple_32_bit_ints_not_self_aligned", "lp64",
+        "ilp32"}});
+}
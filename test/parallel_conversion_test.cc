@@ -0,0 +1,69 @@
+// ABOUT: Parallel conversion must produce exactly what the single-threaded
+//        convert_n produces, for every thread count and chunk size.
+
+#include "include/parallel_conversion.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Ilp32BigEndianDataModel;
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+void expect_parallel_matches_serial(
+    std::size_t count,
+    const little_pp::serialization::ParallelConversionOptions& options) {
+  constexpr std::size_t kSrcSize =
+      little_pp::serialization::serializable_class_size_v<SerializableClassType,
+                                                          SrcDataModelType>;
+  constexpr std::size_t kDstSize =
+      little_pp::serialization::serializable_class_size_v<SerializableClassType,
+                                                          DstDataModelType>;
+  std::vector<unsigned char> src(count * kSrcSize);
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<unsigned char>(i * 31 + 5);
+  }
+  std::vector<unsigned char> expected(count * kDstSize);
+  little_pp::serialization::convert_n<SerializableClassType, SrcDataModelType,
+                                      DstDataModelType>(
+      src.data(), expected.data(), count);
+
+  std::vector<unsigned char> got(count * kDstSize, 0xAA);
+  little_pp::serialization::parallel_convert_n<
+      SerializableClassType, SrcDataModelType, DstDataModelType>(
+      src.data(), got.data(), count, options);
+  EXPECT_EQ(got, expected) << "count: " << count
+                           << ", threads: " << options.thread_count
+                           << ", chunk: " << options.chunk_record_count;
+}
+
+TEST(ParallelConversionTest, MatchesSerialConversion) {
+  for (std::size_t count : {0, 1, 7, 1000, 100003}) {
+    for (std::size_t threads : {0, 1, 2, 5}) {
+      for (std::size_t chunk : {0, 1, 13, 4096}) {
+        const little_pp::serialization::ParallelConversionOptions options{
+            threads, chunk};
+        expect_parallel_matches_serial<CharShortIntCharStruct,
+                                       Lp64LittleEndianDataModel,
+                                       Lp64BigEndianDataModel>(count, options);
+        expect_parallel_matches_serial<CharIntLongStruct,
+                                       Lp64LittleEndianDataModel,
+                                       Ilp32BigEndianDataModel>(count, options);
+      }
+    }
+  }
+}
+
+}  // namespace
@@ -0,0 +1,274 @@
+// ABOUT: The runtime path must agree with the compile-time one: layouts
+//        computed from a DataModelDescriptor are checked against the padding
+//        reflection expectations, and runtime plans must produce the same
+//        bytes as serialize/deserialize.
+
+#include "include/runtime_data_model.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "include/serialization.h"
+#include "lp64_little_endian_host.h"
+#include "test_data/expected_data_char_int_char_short_double_char_struct.h"
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/expected_data_empty_struct.h"
+#include "test_data/expected_data_int_char.h"
+#include "test_data/expected_data_nested_struct.h"
+#include "test_data/expected_data_short_uchar_char_uint_struct.h"
+#include "test_data/expected_data_std_array_struct.h"
+#include "test_data/interface_expected_data.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using little_pp::serialization::DataModelDescriptor;
+using little_pp::serialization::get_runtime_plan;
+using little_pp::serialization::make_data_model_descriptor;
+using test_data::data_models::Ilp32BigEndianDataModel;
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::data_models::
+    Simple32BitButIntsNotSelfAlignedBigEndianDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+using test_data::struct_std_array::CharShortArrayStructArrayStruct;
+
+template <class T>
+class RuntimeLayoutTest : public testing::Test {
+ protected:
+  using ExpectedData = test_data::IExpectedData<T>;
+  using DataModelType =
+      typename test_data::IExpectedData<T>::Parameters::DataModelType;
+  using SerializedType =
+      typename test_data::IExpectedData<T>::Parameters::SerializedType;
+};
+
+using DataModelImplementations = testing::Types<
+    test_data::struct_empty::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_empty::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_short_uchar_char_uint::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_short_uchar_char_uint::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_char_int_long::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_char_int_long::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_int_char::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_int_char::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_char_short_int_char::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_char_short_int_char::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_nested::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_nested::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_std_array::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_std_array::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>,
+    test_data::struct_char_int_char_short_double_char::ExpectedData<
+        test_data::data_models::Simple32BitDataModel>,
+    test_data::struct_char_int_char_short_double_char::ExpectedData<
+        test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>
+    // clang-format off
+>;
+// clang-format on
+
+TYPED_TEST_SUITE(RuntimeLayoutTest, DataModelImplementations);
+
+TYPED_TEST(RuntimeLayoutTest, MatchesExpectedPadding) {
+  using SerializedType = typename TestFixture::SerializedType;
+  using DataModelType = typename TestFixture::DataModelType;
+  const litte_pp::impl::RuntimeLayout layout =
+      litte_pp::impl::make_runtime_layout<SerializedType>(
+          make_data_model_descriptor<DataModelType>());
+
+  EXPECT_EQ(layout.size,
+            (little_pp::serialization::serializable_class_size_v<
+                SerializedType, DataModelType>));
+  ASSERT_EQ(layout.padding_runs.size(),
+            TestFixture::ExpectedData::get_expected_padding_locations_count());
+
+  const auto expected_byte_counts =
+      TestFixture::ExpectedData::get_expected_padding_locations_byte_counts();
+  std::vector<std::size_t> indexes;
+  for (std::size_t i = 0; i < layout.padding_runs.size(); ++i) {
+    const litte_pp::impl::PaddingRun& run = layout.padding_runs[i];
+    EXPECT_EQ(run.size, expected_byte_counts[i]) << "run " << i;
+    for (std::size_t j = 0; j < run.size; ++j) {
+      indexes.push_back(run.offset + j);
+    }
+  }
+  const auto expected_indexes =
+      TestFixture::ExpectedData::get_expected_padding_byte_indexes();
+  EXPECT_EQ(indexes, std::vector<std::size_t>(expected_indexes.begin(),
+                                              expected_indexes.end()));
+}
+
+// Serializes `object` through the compile-time and the runtime path, into
+// buffers prefilled with different garbage, and expects the same bytes.
+template <typename SerializableClassType, typename DataModelType>
+void expect_same_serialization(const SerializableClassType& object) {
+  constexpr std::size_t kSize =
+      little_pp::serialization::serializable_class_size_v<SerializableClassType,
+                                                          DataModelType>;
+  std::vector<unsigned char> expected(kSize, 0xAA);
+  little_pp::serialization::serialize<SerializableClassType,
+                                      Lp64LittleEndianDataModel,
+                                      DataModelType>(object, expected.data());
+
+  const auto& plan = get_runtime_plan<SerializableClassType>(
+      make_data_model_descriptor<DataModelType>());
+  ASSERT_EQ(plan.get_size(), kSize);
+  std::vector<unsigned char> got(kSize, 0x55);
+  plan.serialize(object, got.data());
+  EXPECT_EQ(got, expected);
+}
+
+TEST(RuntimePlanTest, SerializesLikeTheCompileTimePath) {
+  const CharShortIntCharStruct char_short_int_char{'a', -2, 0x01020304, 'z'};
+  expect_same_serialization<CharShortIntCharStruct, Lp64BigEndianDataModel>(
+      char_short_int_char);
+  expect_same_serialization<CharShortIntCharStruct,
+                            Simple32BitButIntsNotSelfAlignedBigEndianDataModel>(
+      char_short_int_char);
+
+  const CharIntLongStruct char_int_long{'c', -2, -3};
+  expect_same_serialization<CharIntLongStruct, Ilp32BigEndianDataModel>(
+      char_int_long);
+  expect_same_serialization<CharIntLongStruct, Lp64LittleEndianDataModel>(
+      char_int_long);
+
+  const CharShortArrayStructArrayStruct nested{
+      't',
+      {{0x0102, 0x0304, 0x0506}},
+      {{{0x0A0B0C0D, 'p'}, {0x11121314, 'q'}}}};
+  expect_same_serialization<CharShortArrayStructArrayStruct,
+                            Lp64BigEndianDataModel>(nested);
+  expect_same_serialization<CharShortArrayStructArrayStruct,
+                            Ilp32BigEndianDataModel>(nested);
+}
+
+TEST(RuntimePlanTest, RoundTripsThroughForeignDataModel) {
+  const auto& plan = get_runtime_plan<CharIntLongStruct>(
+      make_data_model_descriptor<Ilp32BigEndianDataModel>());
+  const std::array<CharIntLongStruct, 3> objects{
+      {{'a', -1, -2}, {'b', 0x7FFFFFFF, 0x12345678}, {'c', 0, -3}}};
+  std::vector<unsigned char> serialized(objects.size() * plan.get_size());
+  plan.serialize_n(objects.data(), serialized.data(), objects.size());
+
+  std::array<CharIntLongStruct, 3> got{};
+  plan.deserialize_n(serialized.data(), got.data(), got.size());
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    EXPECT_EQ(got[i].foo, objects[i].foo);
+    EXPECT_EQ(got[i].bar, objects[i].bar);
+    EXPECT_EQ(got[i].buzz, objects[i].buzz);
+  }
+}
+
+TEST(RuntimePlanTest, IdenticalLayoutsAreASingleCopy) {
+  const auto& plan = get_runtime_plan<CharShortIntCharStruct>(
+      make_data_model_descriptor<Lp64LittleEndianDataModel>());
+  ASSERT_EQ(plan.get_serialize_program().size(), 1U);
+  EXPECT_EQ(plan.get_serialize_program()[0].kind,
+            litte_pp::impl::RuntimeOpKind::kCopy);
+  EXPECT_EQ(plan.get_deserialize_program().size(), 1U);
+}
+
+TEST(RuntimePlanTest, CachesOnePlanPerDescriptor) {
+  const DataModelDescriptor big = make_data_model_descriptor<
+      Lp64BigEndianDataModel>();
+  // the same model, spelled out as a device would report it
+  // NOLINTBEGIN(google-runtime-int)
+  const DataModelDescriptor reported = make_data_model_descriptor(
+      {{1, 1, 1, 1, 1, 1, 4, 4, 2, 2, 2, 2, 4, 4, 4, 4, 8, 8, 8, 8, 8, 8, 8, 8,
+        4, 4, 8, 8, 16, 16, 1, 1}},
+      little_pp::Endianess::kBigEndian);
+  // NOLINTEND(google-runtime-int)
+  EXPECT_EQ(reported, big);
+  EXPECT_EQ(&get_runtime_plan<CharIntLongStruct>(reported),
+            &get_runtime_plan<CharIntLongStruct>(big));
+  EXPECT_NE(&get_runtime_plan<CharIntLongStruct>(big),
+            &get_runtime_plan<CharIntLongStruct>(
+                make_data_model_descriptor<Ilp32BigEndianDataModel>()));
+}
+
+TEST(RuntimePlanTest, RejectsUnsupportedConversions) {
+  struct WithDouble {
+    double value;
+  };
+  DataModelDescriptor narrow_doubles =
+      make_data_model_descriptor<Lp64LittleEndianDataModel>();
+  // double is DataModel's 14th type
+  narrow_doubles.sizes[13] = 4;
+  narrow_doubles.alignments[13] = 4;
+  EXPECT_THROW(get_runtime_plan<WithDouble>(narrow_doubles),
+               std::invalid_argument);
+}
+
+TEST(RuntimePlanTest, RejectsInvalidDescriptors) {
+  const DataModelDescriptor valid =
+      make_data_model_descriptor<Ilp32BigEndianDataModel>();
+  // int is DataModel's 7th type
+  DataModelDescriptor invalid = valid;
+  invalid.alignments[6] = 0;
+  EXPECT_THROW(get_runtime_plan<CharIntLongStruct>(invalid),
+               std::invalid_argument);
+  invalid.alignments[6] = 3;
+  EXPECT_THROW(get_runtime_plan<CharIntLongStruct>(invalid),
+               std::invalid_argument);
+  invalid = valid;
+  invalid.sizes[6] = 0;
+  EXPECT_THROW(get_runtime_plan<CharIntLongStruct>(invalid),
+               std::invalid_argument);
+
+  // only the types the class uses matter
+  DataModelDescriptor without_long_double = valid;
+  // long double is DataModel's 15th type
+  without_long_double.sizes[14] = 0;
+  without_long_double.alignments[14] = 0;
+  EXPECT_EQ(get_runtime_plan<CharIntLongStruct>(without_long_double)
+                .get_size(),
+            12U);
+}
+
+TEST(RuntimePlanTest, RejectsLayoutsBeyondThirtyTwoBitOffsets) {
+  struct Samples {
+    std::array<char, 4> values;
+  };
+  DataModelDescriptor huge_chars =
+      make_data_model_descriptor<Lp64LittleEndianDataModel>();
+  huge_chars.sizes[0] = std::size_t{1} << 31;
+  EXPECT_THROW(get_runtime_plan<Samples>(huge_chars), std::invalid_argument);
+}
+
+TEST(RuntimePlanTest, RejectsLayoutsThatOverflowSizeT) {
+  using litte_pp::impl::SchemaNode;
+  using litte_pp::impl::SchemaNodeKind;
+  using litte_pp::impl::ValueKind;
+  // an array of SIZE_MAX / 2 + 1 shorts; short is DataModel's 5th type
+  const SchemaNode nodes[] = {
+      {SchemaNodeKind::kArray, 0, ValueKind::kUnsigned, SIZE_MAX / 2 + 1},
+      {SchemaNodeKind::kScalar, 4, ValueKind::kSigned, 0},
+  };
+  EXPECT_THROW(litte_pp::impl::RuntimeLayoutBuilder(
+                   make_data_model_descriptor<Lp64LittleEndianDataModel>(),
+                   nodes)
+                   .build(),
+               std::invalid_argument);
+}
+
+}  // namespace
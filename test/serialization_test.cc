@@ -0,0 +1,393 @@
+// ABOUT: Unlike the padding reflection tests, serialization moves bytes at
+//        runtime, so these tests use gtest assertions on the produced buffers.
+//        Lp64LittleEndianDataModel describes the in-memory layout of the test
+//        structs (see lp64_little_endian_host.h).
+
+#include "include/serialization.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "lp64_little_endian_host.h"
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/expected_data_int_char.h"
+#include "test_data/expected_data_short_uchar_char_uint_struct.h"
+#include "test_data/expected_data_std_array_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Ilp32BigEndianDataModel;
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::data_models::
+    Simple32BitButIntsNotSelfAlignedBigEndianDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+using test_data::struct_int_char::IntCharStruct;
+using test_data::struct_short_uchar_char_uint::ShortUCharCharIntStruct;
+using test_data::struct_std_array::CharShortArrayStructArrayStruct;
+
+template <typename SerializableClassType, typename DataModelType>
+using SerializedBuffer = std::array<
+    unsigned char, little_pp::serialization::serializable_class_size_v<
+                       SerializableClassType, DataModelType>>;
+
+TEST(SerializationTest, SerializedSizeIncludesTrailingPadding) {
+  static_assert(little_pp::serialization::serializable_class_size_v<
+                    IntCharStruct, Lp64LittleEndianDataModel> == 8,
+                "");
+  static_assert(
+      little_pp::serialization::serializable_class_size_v<
+          IntCharStruct, Simple32BitButIntsNotSelfAlignedBigEndianDataModel> ==
+          6,
+      "");
+  static_assert(little_pp::serialization::serializable_class_size_v<
+                    CharIntLongStruct, Ilp32BigEndianDataModel> == 12,
+                "");
+}
+
+TEST(SerializationTest, ContiguousFieldsMergeIntoOneCopy) {
+  // short, int and the last char sit back to back in both layouts
+  using Plan = litte_pp::impl::CopyPlan<
+      CharShortIntCharStruct, Lp64LittleEndianDataModel,
+      test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>;
+  static_assert(Plan::kRunCount == 4, "");
+  static_assert(Plan::kRuns[2].kind == litte_pp::impl::RunKind::kCopy, "");
+  static_assert(Plan::kRuns[2].src_offset == 2, "");
+  static_assert(Plan::kRuns[2].src_size == 7, "");
+}
+
+TEST(SerializationTest, DetectsIdenticalLayouts) {
+  static_assert(little_pp::serialization::is_layout_identical_v<
+                    IntCharStruct, Lp64LittleEndianDataModel,
+                    Lp64LittleEndianDataModel>,
+                "");
+  // The data models differ (e.g. wchar_t), but not for the types used.
+  static_assert(little_pp::serialization::is_layout_identical_v<
+                    CharShortIntCharStruct, Lp64LittleEndianDataModel,
+                    test_data::data_models::Simple32BitDataModel>,
+                "");
+  static_assert(!little_pp::serialization::is_layout_identical_v<
+                    IntCharStruct, Lp64LittleEndianDataModel,
+                    Lp64BigEndianDataModel>,
+                "");
+  static_assert(!little_pp::serialization::is_layout_identical_v<
+                    CharIntLongStruct, Lp64BigEndianDataModel,
+                    Ilp32BigEndianDataModel>,
+                "");
+}
+
+TEST(SerializationTest, IdenticalLayoutsAreASingleCopy) {
+  using Plan = litte_pp::impl::CopyPlan<CharShortIntCharStruct,
+                                        Lp64LittleEndianDataModel,
+                                        Lp64LittleEndianDataModel>;
+  static_assert(Plan::kRunCount == 1, "");
+  static_assert(Plan::kRuns[0].kind == litte_pp::impl::RunKind::kCopy, "");
+  static_assert(Plan::kRuns[0].src_size == sizeof(CharShortIntCharStruct),
+                "");
+
+  // padding bytes are copied as-is rather than zeroed
+  std::array<unsigned char, sizeof(CharShortIntCharStruct)> src{};
+  src.fill(0xAA);
+  decltype(src) got{};
+  little_pp::serialization::convert<CharShortIntCharStruct,
+                                    Lp64LittleEndianDataModel,
+                                    Lp64LittleEndianDataModel>(src.data(),
+                                                               got.data());
+  EXPECT_EQ(got, src);
+}
+
+TEST(SerializationTest, SwapsByteOrderAndRepacks) {
+  const IntCharStruct object{0x11223344, 'x'};
+  SerializedBuffer<IntCharStruct,
+                   Simple32BitButIntsNotSelfAlignedBigEndianDataModel>
+      got{};
+  got.fill(0xAA);
+
+  little_pp::serialization::serialize<
+      IntCharStruct, Lp64LittleEndianDataModel,
+      Simple32BitButIntsNotSelfAlignedBigEndianDataModel>(object, got.data());
+
+  const decltype(got) expected{0x11, 0x22, 0x33, 0x44, 'x', 0x00};
+  EXPECT_EQ(got, expected);
+}
+
+TEST(SerializationTest, ZeroesDestinationPadding) {
+  const CharShortIntCharStruct object{'a', 0x0102, 0x03040506, 'b'};
+  SerializedBuffer<CharShortIntCharStruct, Lp64BigEndianDataModel> got{};
+  got.fill(0xAA);
+
+  little_pp::serialization::serialize<CharShortIntCharStruct,
+                                      Lp64LittleEndianDataModel,
+                                      Lp64BigEndianDataModel>(object,
+                                                              got.data());
+
+  const decltype(got) expected{'a',  0x00, 0x01, 0x02, 0x03, 0x04,
+                               0x05, 0x06, 'b',  0x00, 0x00, 0x00};
+  EXPECT_EQ(got, expected);
+}
+
+TEST(SerializationTest, PreservesDestinationPadding) {
+  using little_pp::serialization::PaddingPolicy;
+  // identical layouts; the fields and the one padding byte between them are
+  // blended in as one run, the trailing padding is not touched
+  using Plan =
+      litte_pp::impl::CopyPlan<CharShortIntCharStruct,
+                               Lp64LittleEndianDataModel,
+                               Lp64LittleEndianDataModel,
+                               PaddingPolicy::kPreserve>;
+  static_assert(Plan::kRunCount == 1, "");
+  static_assert(Plan::kRuns[0].kind == litte_pp::impl::RunKind::kMaskedCopy,
+                "");
+  static_assert(Plan::kRuns[0].dst_size == 9, "");
+
+  std::array<unsigned char, sizeof(CharShortIntCharStruct)> src{};
+  src.fill(0x55);
+  decltype(src) got{};
+  got.fill(0xAA);
+  little_pp::serialization::convert<
+      CharShortIntCharStruct, Lp64LittleEndianDataModel,
+      Lp64LittleEndianDataModel, PaddingPolicy::kPreserve>(src.data(),
+                                                           got.data());
+  const decltype(got) expected{0x55, 0xAA, 0x55, 0x55, 0x55, 0x55,
+                               0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA};
+  EXPECT_EQ(got, expected);
+
+  const CharShortIntCharStruct object{'a', 0x0102, 0x03040506, 'b'};
+  SerializedBuffer<CharShortIntCharStruct, Lp64BigEndianDataModel> swapped{};
+  swapped.fill(0xAA);
+  little_pp::serialization::serialize<
+      CharShortIntCharStruct, Lp64LittleEndianDataModel,
+      Lp64BigEndianDataModel, PaddingPolicy::kPreserve>(object,
+                                                        swapped.data());
+  const decltype(swapped) expected_swapped{'a',  0xAA, 0x01, 0x02,
+                                           0x03, 0x04, 0x05, 0x06,
+                                           'b',  0xAA, 0xAA, 0xAA};
+  EXPECT_EQ(swapped, expected_swapped);
+}
+
+TEST(SerializationTest, SkipsDestinationPadding) {
+  using little_pp::serialization::PaddingPolicy;
+  // no run covers a padding byte, not even between identical layouts
+  using Plan = litte_pp::impl::CopyPlan<CharShortIntCharStruct,
+                                        Lp64LittleEndianDataModel,
+                                        Lp64LittleEndianDataModel,
+                                        PaddingPolicy::kSkip>;
+  static_assert(Plan::kRunCount == 2, "");
+  static_assert(Plan::kRuns[0].dst_offset == 0, "");
+  static_assert(Plan::kRuns[0].dst_size == 1, "");
+  static_assert(Plan::kRuns[1].dst_offset == 2, "");
+  static_assert(Plan::kRuns[1].dst_size == 7, "");
+
+  std::vector<CharShortIntCharStruct> objects{
+      {'a', 0x0102, 0x03040506, 'b'}, {'c', 0x0708, 0x090A0B0C, 'd'}};
+  std::vector<unsigned char> got(
+      2 * little_pp::serialization::serializable_class_size_v<
+              CharShortIntCharStruct, Lp64BigEndianDataModel>,
+      0xAA);
+  little_pp::serialization::convert_n<
+      CharShortIntCharStruct, Lp64LittleEndianDataModel,
+      Lp64BigEndianDataModel, PaddingPolicy::kSkip>(
+      reinterpret_cast<const unsigned char*>(objects.data()), got.data(),
+      objects.size());
+  const std::vector<unsigned char> expected{
+      'a', 0xAA, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 'b', 0xAA, 0xAA, 0xAA,
+      'c', 0xAA, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 'd', 0xAA, 0xAA, 0xAA};
+  EXPECT_EQ(got, expected);
+}
+
+TEST(SerializationTest, NarrowsAndSignExtendsIntegers) {
+  const CharIntLongStruct object{'c', -2, -3};
+  SerializedBuffer<CharIntLongStruct, Ilp32BigEndianDataModel> serialized{};
+
+  little_pp::serialization::serialize<CharIntLongStruct,
+                                      Lp64LittleEndianDataModel,
+                                      Ilp32BigEndianDataModel>(
+      object, serialized.data());
+
+  const decltype(serialized) expected{'c',  0x00, 0x00, 0x00, 0xFF, 0xFF,
+                                      0xFF, 0xFE, 0xFF, 0xFF, 0xFF, 0xFD};
+  EXPECT_EQ(serialized, expected);
+
+  CharIntLongStruct got{};
+  little_pp::serialization::deserialize<
+      CharIntLongStruct, Ilp32BigEndianDataModel, Lp64LittleEndianDataModel>(
+      serialized.data(), got);
+  EXPECT_EQ(got.foo, 'c');
+  EXPECT_EQ(got.bar, -2);
+  EXPECT_EQ(got.buzz, -3);
+}
+
+TEST(SerializationTest, RoundTripsThroughForeignDataModel) {
+  const ShortUCharCharIntStruct object{-1234, 200, 'z', 0x7FEDCBA9};
+  SerializedBuffer<ShortUCharCharIntStruct, Lp64BigEndianDataModel>
+      serialized{};
+  little_pp::serialization::serialize<ShortUCharCharIntStruct,
+                                      Lp64LittleEndianDataModel,
+                                      Lp64BigEndianDataModel>(
+      object, serialized.data());
+
+  ShortUCharCharIntStruct got{};
+  little_pp::serialization::deserialize<ShortUCharCharIntStruct,
+                                        Lp64BigEndianDataModel,
+                                        Lp64LittleEndianDataModel>(
+      serialized.data(), got);
+  EXPECT_EQ(got.a, object.a);
+  EXPECT_EQ(got.b, object.b);
+  EXPECT_EQ(got.c, object.c);
+  EXPECT_EQ(got.d, object.d);
+}
+
+TEST(SerializationTest, PacksFieldsBackToBack) {
+  using WireModel = little_pp::Packed<Lp64BigEndianDataModel>;
+  static_assert(little_pp::serialization::serializable_class_size_v<
+                    CharShortIntCharStruct, WireModel> == 8,
+                "Packed layouts have no padding.");
+
+  const CharShortIntCharStruct object{'a', 0x0102, 0x03040506, 'b'};
+  SerializedBuffer<CharShortIntCharStruct, WireModel> serialized{};
+  little_pp::serialization::serialize<CharShortIntCharStruct,
+                                      Lp64LittleEndianDataModel, WireModel>(
+      object, serialized.data());
+
+  const decltype(serialized) expected{'a',  0x01, 0x02, 0x03,
+                                      0x04, 0x05, 0x06, 'b'};
+  EXPECT_EQ(serialized, expected);
+
+  CharShortIntCharStruct got{};
+  little_pp::serialization::deserialize<CharShortIntCharStruct, WireModel,
+                                        Lp64LittleEndianDataModel>(
+      serialized.data(), got);
+  EXPECT_EQ(got.bar, object.bar);
+  EXPECT_EQ(got.foo, object.foo);
+  EXPECT_EQ(got.baz, object.baz);
+  EXPECT_EQ(got.buzz, object.buzz);
+}
+
+// Compares the batch conversion against converting one record at a time.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+void expect_batch_matches_single(std::size_t count) {
+  constexpr std::size_t kSrcSize =
+      little_pp::serialization::serializable_class_size_v<SerializableClassType,
+                                                          SrcDataModelType>;
+  constexpr std::size_t kDstSize =
+      little_pp::serialization::serializable_class_size_v<SerializableClassType,
+                                                          DstDataModelType>;
+  std::vector<unsigned char> src(count * kSrcSize);
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<unsigned char>(i * 7 + 3);
+  }
+  std::vector<unsigned char> expected(count * kDstSize);
+  for (std::size_t i = 0; i < count; ++i) {
+    little_pp::serialization::convert<SerializableClassType, SrcDataModelType,
+                                      DstDataModelType>(
+        src.data() + i * kSrcSize, expected.data() + i * kDstSize);
+  }
+
+  std::vector<unsigned char> got(count * kDstSize, 0xAA);
+  little_pp::serialization::convert_n<SerializableClassType, SrcDataModelType,
+                                      DstDataModelType>(src.data(), got.data(),
+                                                        count);
+  EXPECT_EQ(got, expected) << "count: " << count;
+}
+
+TEST(SerializationTest, FlattensNestedAndArrayMembers) {
+  const CharShortArrayStructArrayStruct object{
+      't',
+      {{0x0102, 0x0304, 0x0506}},
+      {{{0x0A0B0C0D, 'p'}, {0x11121314, 'q'}}}};
+  SerializedBuffer<CharShortArrayStructArrayStruct, Lp64BigEndianDataModel>
+      serialized{};
+  serialized.fill(0xAA);
+
+  little_pp::serialization::serialize<CharShortArrayStructArrayStruct,
+                                      Lp64LittleEndianDataModel,
+                                      Lp64BigEndianDataModel>(
+      object, serialized.data());
+
+  const decltype(serialized) expected{
+      't',  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x0A, 0x0B, 0x0C, 0x0D,
+      'p',  0x00, 0x00, 0x00, 0x11, 0x12, 0x13, 0x14, 'q',  0x00, 0x00, 0x00};
+  EXPECT_EQ(serialized, expected);
+
+  CharShortArrayStructArrayStruct got{};
+  little_pp::serialization::deserialize<CharShortArrayStructArrayStruct,
+                                        Lp64BigEndianDataModel,
+                                        Lp64LittleEndianDataModel>(
+      serialized.data(), got);
+  EXPECT_EQ(got.tag, object.tag);
+  EXPECT_EQ(got.samples, object.samples);
+  EXPECT_EQ(got.items[1].x, object.items[1].x);
+  EXPECT_EQ(got.items[1].y, object.items[1].y);
+}
+
+TEST(SerializationTest, BatchShufflesCoverWholePeriodsOfRecords) {
+  using Batch = litte_pp::impl::BatchConversion<
+      IntCharStruct, Lp64LittleEndianDataModel,
+      Simple32BitButIntsNotSelfAlignedBigEndianDataModel>;
+  static_assert(Batch::kIsShuffleable, "");
+  // 6-byte records: lcm(6, 16) = 48 bytes, 8 records in 3 vectors
+  static_assert(Batch::kPeriodRecords == 8, "");
+  static_assert(Batch::kPeriodVectors == 3, "");
+  constexpr litte_pp::impl::ShuffleVector kFirst =
+      Batch::kShuffles.vectors[0];
+  static_assert(kFirst.src_offset == 0, "");
+  // second record: int swapped from source bytes 8..11, char from 12
+  static_assert(kFirst.low[6] == 11, "");
+  static_assert(kFirst.low[9] == 8, "");
+  static_assert(kFirst.low[10] == 12, "");
+  static_assert(kFirst.low[11] == litte_pp::impl::kShuffleZero, "");
+  // the third record's int starts in the vector, from source bytes 16..19
+  static_assert(kFirst.needs_high, "");
+  static_assert(kFirst.low[12] == litte_pp::impl::kShuffleZero, "");
+  static_assert(kFirst.high[12] == 3, "");
+
+  // records that span vectors
+  static_assert(litte_pp::impl::BatchConversion<
+                    CharShortIntCharStruct, Lp64BigEndianDataModel,
+                    Lp64LittleEndianDataModel>::kPeriodRecords == 4,
+                "");
+  using WideBatch = litte_pp::impl::BatchConversion<
+      CharShortArrayStructArrayStruct, Lp64LittleEndianDataModel,
+      Lp64BigEndianDataModel>;
+  static_assert(WideBatch::kIsShuffleable, "");
+  static_assert(WideBatch::kPeriodRecords == 2, "");
+
+  // widths change, so only the scalar plan applies
+  static_assert(!litte_pp::impl::BatchConversion<
+                    CharIntLongStruct, Lp64LittleEndianDataModel,
+                    Ilp32BigEndianDataModel>::kIsShuffleable,
+                "");
+}
+
+TEST(SerializationTest, BatchConversionMatchesSingleRecordConversion) {
+  for (std::size_t count : {0, 1, 2, 3, 5, 8, 17, 64, 101}) {
+    expect_batch_matches_single<
+        IntCharStruct, Lp64LittleEndianDataModel,
+        Simple32BitButIntsNotSelfAlignedBigEndianDataModel>(count);
+    expect_batch_matches_single<CharShortIntCharStruct, Lp64BigEndianDataModel,
+                                Lp64LittleEndianDataModel>(count);
+    expect_batch_matches_single<ShortUCharCharIntStruct,
+                                Lp64LittleEndianDataModel,
+                                Lp64LittleEndianDataModel>(count);
+    expect_batch_matches_single<CharIntLongStruct, Lp64LittleEndianDataModel,
+                                Ilp32BigEndianDataModel>(count);
+    expect_batch_matches_single<
+        CharShortIntCharStruct, little_pp::Packed<Lp64BigEndianDataModel>,
+        Lp64LittleEndianDataModel>(count);
+    expect_batch_matches_single<CharShortArrayStructArrayStruct,
+                                Lp64LittleEndianDataModel,
+                                Lp64BigEndianDataModel>(count);
+    expect_batch_matches_single<CharIntLongStruct, Lp64LittleEndianDataModel,
+                                Lp64BigEndianDataModel>(count);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,168 @@
+// ABOUT: Views read (and refs write) single fields straight in serialized
+//        buffers; every field must round-trip through the full serializer.
+
+#include "include/serialized_view.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "include/serialization.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/expected_data_nested_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Ilp32BigEndianDataModel;
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_nested::CharIntCharCharStruct;
+
+enum class Mode : std::uint16_t { kIdle = 1, kRunning = 0x0203 };
+
+struct StatusBlock {
+  bool enabled;
+  Mode mode;
+  float temperature;
+  double voltage;
+  std::uint8_t flags;
+};
+
+template <typename SerializableClassType, typename DataModelType>
+using SerializedBuffer = std::array<
+    unsigned char, little_pp::serialization::serializable_class_size_v<
+                       SerializableClassType, DataModelType>>;
+
+TEST(SerializedViewTest, ReadsEveryFieldOfForeignLayout) {
+  const StatusBlock object{true, Mode::kRunning, 21.5F, -3.25, 0x81};
+  SerializedBuffer<StatusBlock, Lp64BigEndianDataModel> serialized{};
+  little_pp::serialization::serialize<StatusBlock, Lp64LittleEndianDataModel,
+                                      Lp64BigEndianDataModel>(
+      object, serialized.data());
+
+  const little_pp::serialization::SerializedView<StatusBlock,
+                                                 Lp64BigEndianDataModel>
+      view(serialized.data());
+  EXPECT_EQ(view.get<0>(), object.enabled);
+  EXPECT_EQ(view.get<1>(), object.mode);
+  EXPECT_EQ(view.get<2>(), object.temperature);
+  EXPECT_EQ(view.get<3>(), object.voltage);
+  EXPECT_EQ(view.get<4>(), object.flags);
+}
+
+TEST(SerializedViewTest, ReadsBigEndianBytesAtLayoutOffset) {
+  // enum field at offset 2, big-endian
+  SerializedBuffer<StatusBlock, Lp64BigEndianDataModel> serialized{};
+  serialized[2] = 0x00;
+  serialized[3] = 0x01;
+  const little_pp::serialization::SerializedView<StatusBlock,
+                                                 Lp64BigEndianDataModel>
+      view(serialized.data());
+  EXPECT_EQ(view.get<1>(), Mode::kIdle);
+}
+
+TEST(SerializedViewTest, WidensNarrowerSerializedFields) {
+  const CharIntLongStruct object{'x', -7, -123456};
+  SerializedBuffer<CharIntLongStruct, Ilp32BigEndianDataModel> serialized{};
+  little_pp::serialization::serialize<CharIntLongStruct,
+                                      Lp64LittleEndianDataModel,
+                                      Ilp32BigEndianDataModel>(
+      object, serialized.data());
+
+  const little_pp::serialization::SerializedView<CharIntLongStruct,
+                                                 Ilp32BigEndianDataModel>
+      view(serialized.data());
+  EXPECT_EQ(view.get<0>(), 'x');
+  EXPECT_EQ(view.get<1>(), -7);
+  EXPECT_EQ(view.get<2>(), -123456);
+}
+
+TEST(SerializedViewTest, ChainsIntoNestedMembers) {
+  const CharIntCharCharStruct object{'a', {-42, 'y'}, 'b'};
+  SerializedBuffer<CharIntCharCharStruct, Lp64BigEndianDataModel> serialized{};
+  little_pp::serialization::serialize<CharIntCharCharStruct,
+                                      Lp64LittleEndianDataModel,
+                                      Lp64BigEndianDataModel>(
+      object, serialized.data());
+
+  const little_pp::serialization::SerializedView<CharIntCharCharStruct,
+                                                 Lp64BigEndianDataModel>
+      view(serialized.data());
+  EXPECT_EQ(view.get<1>().get<0>(), -42);
+  EXPECT_EQ(view.get<1>().get<1>(), 'y');
+  EXPECT_EQ(view.get<2>(), 'b');
+}
+
+TEST(SerializedRefTest, StoresSingleFieldAndLeavesPaddingUntouched) {
+  SerializedBuffer<StatusBlock, Lp64BigEndianDataModel> image{};
+  image.fill(0xAA);
+  const little_pp::serialization::SerializedRef<StatusBlock,
+                                                Lp64BigEndianDataModel>
+      ref(image.data());
+
+  ref.set<1>(Mode::kRunning);
+
+  decltype(image) expected{};
+  expected.fill(0xAA);
+  expected[2] = 0x02;
+  expected[3] = 0x03;
+  EXPECT_EQ(image, expected);
+  EXPECT_EQ(ref.get<1>(), Mode::kRunning);
+}
+
+TEST(SerializedRefTest, RoundTripsEveryField) {
+  SerializedBuffer<StatusBlock, Lp64BigEndianDataModel> image{};
+  const little_pp::serialization::SerializedRef<StatusBlock,
+                                                Lp64BigEndianDataModel>
+      ref(image.data());
+  ref.set<0>(true);
+  ref.set<1>(Mode::kIdle);
+  ref.set<2>(-0.5F);
+  ref.set<3>(1e100);
+  ref.set<4>(0x7F);
+
+  StatusBlock got{};
+  little_pp::serialization::deserialize<StatusBlock, Lp64BigEndianDataModel,
+                                        Lp64LittleEndianDataModel>(
+      image.data(), got);
+  EXPECT_EQ(got.enabled, true);
+  EXPECT_EQ(got.mode, Mode::kIdle);
+  EXPECT_EQ(got.temperature, -0.5F);
+  EXPECT_EQ(got.voltage, 1e100);
+  EXPECT_EQ(got.flags, 0x7F);
+}
+
+TEST(SerializedRefTest, SetsNestedMemberInPlace) {
+  SerializedBuffer<CharIntCharCharStruct, Lp64BigEndianDataModel> image{};
+  const little_pp::serialization::SerializedRef<CharIntCharCharStruct,
+                                                Lp64BigEndianDataModel>
+      ref(image.data());
+
+  ref.get<1>().set<0>(0x01020304);
+
+  EXPECT_EQ(image[4], 0x01);
+  EXPECT_EQ(image[7], 0x04);
+  EXPECT_EQ(ref.get<1>().get<0>(), 0x01020304);
+}
+
+TEST(SerializedRefTest, NarrowsIntoVolatileMemory) {
+  volatile unsigned char image[little_pp::serialization::
+                                   serializable_class_size_v<
+                                       CharIntLongStruct,
+                                       Ilp32BigEndianDataModel>] = {};
+  const little_pp::serialization::SerializedRef<
+      CharIntLongStruct, Ilp32BigEndianDataModel, volatile unsigned char>
+      ref(image);
+
+  ref.set<2>(-2L);
+
+  EXPECT_EQ(image[8], 0xFF);
+  EXPECT_EQ(image[11], 0xFE);
+  EXPECT_EQ(image[7], 0x00);
+  EXPECT_EQ(ref.get<2>(), -2L);
+}
+
+}  // namespace
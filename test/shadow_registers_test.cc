@@ -0,0 +1,188 @@
+// ABOUT: Shadow registers must write exactly the dirty fields, in as few
+//        transactions as the bus options allow, and leave the device image
+//        equal to the serialized shadow.
+
+#include "include/shadow_registers.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "include/serialization.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using little_pp::serialization::RegisterWriteOptions;
+using little_pp::serialization::WriteTransaction;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::data_models::Simple32BitBigEndianDataModel;
+using test_data::data_models::
+    Simple32BitButIntsNotSelfAlignedBigEndianDataModel;
+
+struct CoprocessorRegisters {
+  std::uint8_t control;                 // 0
+  std::uint8_t mode;                    // 1
+  std::uint16_t divider;                // 2
+  std::uint32_t threshold;              // 4
+  std::uint32_t gain;                   // 8
+  std::uint32_t bias;                   // 12
+  std::array<std::uint32_t, 4> coeffs;  // 16
+  std::uint32_t irq_mask;               // 32
+};
+
+enum Field : std::size_t {
+  kControl,
+  kMode,
+  kDivider,
+  kThreshold,
+  kGain,
+  kBias,
+  kCoeffs,
+  kIrqMask,
+};
+
+using Registers = little_pp::serialization::ShadowRegisters<
+    CoprocessorRegisters, Lp64LittleEndianDataModel,
+    Simple32BitBigEndianDataModel>;
+
+// The device only aligns 32-bit registers to 2 bytes.
+struct UnalignedRegisterBlock {
+  std::uint16_t status;  // 0
+  std::uint32_t low;     // 2
+  std::uint32_t high;    // 6
+  std::uint16_t flags;   // 10
+};
+
+using UnalignedRegisters = little_pp::serialization::ShadowRegisters<
+    UnalignedRegisterBlock, Lp64LittleEndianDataModel,
+    Simple32BitButIntsNotSelfAlignedBigEndianDataModel>;
+
+template <typename RegistersType>
+auto plan(const RegistersType& registers) -> std::vector<WriteTransaction> {
+  std::vector<WriteTransaction> transactions;
+  registers.plan([&](const WriteTransaction& transaction) {
+    transactions.push_back(transaction);
+  });
+  return transactions;
+}
+
+void expect_transactions(const std::vector<WriteTransaction>& got,
+                         const std::vector<WriteTransaction>& expected) {
+  ASSERT_EQ(got.size(), expected.size());
+  for (std::size_t i = 0; i < got.size(); ++i) {
+    EXPECT_EQ(got[i].offset, expected[i].offset) << "transaction " << i;
+    EXPECT_EQ(got[i].size, expected[i].size) << "transaction " << i;
+  }
+}
+
+// Keeps a fake device's memory in sync through the write callback.
+class FakeDevice {
+ public:
+  auto sync(Registers& registers) -> std::size_t {
+    return registers.sync([this](std::size_t offset,
+                                 const unsigned char* bytes,
+                                 std::size_t size) {
+      std::memcpy(memory_.data() + offset, bytes, size);
+    });
+  }
+
+  auto get_memory() const -> const std::array<unsigned char, 36>& {
+    return memory_;
+  }
+
+ private:
+  std::array<unsigned char, 36> memory_{};
+};
+
+TEST(ShadowRegistersTest, FirstSyncWritesTheWholeBlock) {
+  static_assert(Registers::kDeviceSize == 36, "");
+  Registers registers;
+  expect_transactions(plan(registers), {{0, 36}});
+  FakeDevice device;
+  EXPECT_EQ(device.sync(registers), 1U);
+  EXPECT_FALSE(registers.is_dirty());
+  EXPECT_TRUE(plan(registers).empty());
+}
+
+TEST(ShadowRegistersTest, CoalescesSpansAcrossSmallGaps) {
+  Registers registers;
+  FakeDevice device;
+  device.sync(registers);
+
+  registers.set<kThreshold>(1);
+  registers.set<kBias>(2);     // 4 clean bytes after threshold
+  registers.set<kIrqMask>(3);  // 16 clean bytes after bias
+  expect_transactions(plan(registers), {{4, 12}, {32, 4}});
+
+  Registers eager({}, RegisterWriteOptions{24, 0, 1});
+  FakeDevice eager_device;
+  eager_device.sync(eager);
+  eager.set<kThreshold>(1);
+  eager.set<kIrqMask>(3);
+  expect_transactions(plan(eager), {{4, 32}});
+}
+
+TEST(ShadowRegistersTest, IgnoresUnchangedValues) {
+  Registers registers;
+  FakeDevice device;
+  device.sync(registers);
+  registers.set<kGain>(0);
+  EXPECT_FALSE(registers.is_dirty());
+  registers.mark_dirty<kGain>();
+  expect_transactions(plan(registers), {{8, 4}});
+}
+
+TEST(ShadowRegistersTest, WidensToTheAccessWidth) {
+  Registers registers({}, RegisterWriteOptions{0, 0, 4});
+  FakeDevice device;
+  device.sync(registers);
+  registers.set<kMode>(7);
+  expect_transactions(plan(registers), {{0, 4}});
+}
+
+TEST(ShadowRegistersTest, SplitsTransactionsIntoBursts) {
+  Registers registers({}, RegisterWriteOptions{4, 8, 4});
+  expect_transactions(plan(registers),
+                      {{0, 8}, {8, 8}, {16, 8}, {24, 8}, {32, 4}});
+}
+
+TEST(ShadowRegistersTest, DoesNotRewriteBytesWhenWideningOverlaps) {
+  static_assert(UnalignedRegisters::kDeviceSize == 12, "");
+  const UnalignedRegisters registers({}, RegisterWriteOptions{4, 8, 4});
+  // status and low widen to [0, 8); high widens to [4, 12) but only [8, 12)
+  // is left to write, and flags is already covered
+  expect_transactions(plan(registers), {{0, 8}, {8, 4}});
+}
+
+TEST(ShadowRegistersTest, RejectsInconsistentOptions) {
+  EXPECT_THROW(Registers({}, RegisterWriteOptions{4, 0, 0}),
+               std::invalid_argument);
+  EXPECT_THROW(Registers({}, RegisterWriteOptions{4, 6, 4}),
+               std::invalid_argument);
+}
+
+TEST(ShadowRegistersTest, DeviceMatchesTheSerializedShadow) {
+  Registers registers;
+  FakeDevice device;
+  device.sync(registers);
+  registers.set<kDivider>(0x1234);
+  registers.set<kCoeffs>({{1, 2, 3, 4}});
+  registers.set<kControl>(0x80);
+  device.sync(registers);
+
+  std::array<unsigned char, 36> expected{};
+  little_pp::serialization::serialize<CoprocessorRegisters,
+                                      Lp64LittleEndianDataModel,
+                                      Simple32BitBigEndianDataModel>(
+      registers.get_object(), expected.data());
+  EXPECT_EQ(device.get_memory(), expected);
+  EXPECT_EQ(registers.get<kDivider>(), 0x1234);
+}
+
+}  // namespace
@@ -0,0 +1,190 @@
+// ABOUT: Chunked serialization must reproduce serialize()'s output, and
+//        chunked deserialization deserialize()'s, for every chunk size,
+//        including chunks that split converted fields.
+
+#include "include/streaming.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "include/serialization.h"
+#include "test_data/expected_data_char_short_int_char_struct.h"
+#include "test_data/expected_data_char_short_int_struct.h"
+#include "test_data/tested_data_models.h"
+
+namespace {
+
+using test_data::data_models::Ilp32BigEndianDataModel;
+using test_data::data_models::Lp64BigEndianDataModel;
+using test_data::data_models::Lp64LittleEndianDataModel;
+using test_data::struct_char_int_long::CharIntLongStruct;
+using test_data::struct_char_short_int_char::CharShortIntCharStruct;
+
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+void expect_chunks_match_serialize(const SerializableClassType& object) {
+  constexpr std::size_t kSize =
+      little_pp::serialization::serializable_class_size_v<SerializableClassType,
+                                                          DstDataModelType>;
+  std::vector<unsigned char> expected(kSize);
+  little_pp::serialization::serialize<SerializableClassType, SrcDataModelType,
+                                      DstDataModelType>(object,
+                                                        expected.data());
+
+  for (std::size_t chunk_size = 1; chunk_size <= kSize + 1; ++chunk_size) {
+    little_pp::serialization::ChunkedSerializer<
+        SerializableClassType, SrcDataModelType, DstDataModelType>
+        serializer(object);
+    std::vector<unsigned char> got;
+    std::vector<unsigned char> chunk(chunk_size, 0xAA);
+    while (!serializer.is_done()) {
+      const std::size_t written = serializer.write(chunk.data(), chunk.size());
+      got.insert(got.end(), chunk.begin(), chunk.begin() + written);
+      EXPECT_EQ(serializer.get_remaining_size(), kSize - got.size());
+    }
+    EXPECT_EQ(got, expected) << "chunk size: " << chunk_size;
+    EXPECT_EQ(serializer.write(chunk.data(), chunk.size()), 0U);
+  }
+}
+
+// Deserializes `serialized` in fragments of every size and byte by byte; the
+// objects must be bitwise equal to deserialize()'s, padding included.
+template <typename SerializableClassType, typename SrcDataModelType,
+          typename DstDataModelType>
+void expect_fragments_match_deserialize(
+    const std::vector<unsigned char>& serialized) {
+  SerializableClassType expected;
+  std::memset(&expected, 0xAA, sizeof(expected));
+  little_pp::serialization::deserialize<SerializableClassType,
+                                        SrcDataModelType, DstDataModelType>(
+      serialized.data(), expected);
+
+  for (std::size_t fragment_size = 1; fragment_size <= serialized.size() + 1;
+       ++fragment_size) {
+    SerializableClassType got;
+    std::memset(&got, 0xAA, sizeof(got));
+    little_pp::serialization::ChunkedDeserializer<
+        SerializableClassType, SrcDataModelType, DstDataModelType>
+        deserializer(got);
+    std::size_t offset = 0;
+    while (!deserializer.is_done()) {
+      const std::size_t size = (serialized.size() - offset < fragment_size)
+                                   ? serialized.size() - offset
+                                   : fragment_size;
+      offset += deserializer.read(serialized.data() + offset, size);
+      EXPECT_EQ(deserializer.get_remaining_size(), serialized.size() - offset);
+    }
+    EXPECT_EQ(std::memcmp(&got, &expected, sizeof(got)), 0)
+        << "fragment size: " << fragment_size;
+  }
+
+  SerializableClassType got;
+  std::memset(&got, 0xAA, sizeof(got));
+  little_pp::serialization::ChunkedDeserializer<
+      SerializableClassType, SrcDataModelType, DstDataModelType>
+      deserializer(got);
+  for (std::size_t i = 0; i < serialized.size(); ++i) {
+    EXPECT_EQ(deserializer.push(serialized[i]), i + 1 == serialized.size());
+  }
+  EXPECT_EQ(std::memcmp(&got, &expected, sizeof(got)), 0);
+}
+
+TEST(StreamingTest, ChunksConcatenateToSerializedClass) {
+  expect_chunks_match_serialize<CharShortIntCharStruct,
+                                Lp64LittleEndianDataModel,
+                                Lp64BigEndianDataModel>(
+      CharShortIntCharStruct{'a', 0x0102, 0x03040506, 'b'});
+  expect_chunks_match_serialize<CharIntLongStruct, Lp64LittleEndianDataModel,
+                                Ilp32BigEndianDataModel>(
+      CharIntLongStruct{'c', -2, 0x0708090A0B});
+  // identical layouts are a single copy run
+  expect_chunks_match_serialize<CharIntLongStruct, Lp64LittleEndianDataModel,
+                                Lp64LittleEndianDataModel>(
+      CharIntLongStruct{'c', -2, 0x0708090A0B});
+}
+
+TEST(StreamingTest, ResetRestartsFromFirstByte) {
+  const CharShortIntCharStruct first{'a', 1, 2, 'b'};
+  const CharShortIntCharStruct second{'c', 3, 4, 'd'};
+  little_pp::serialization::ChunkedSerializer<
+      CharShortIntCharStruct, Lp64LittleEndianDataModel, Lp64BigEndianDataModel>
+      serializer(first);
+  unsigned char chunk[5];
+  serializer.write(chunk, sizeof(chunk));
+  EXPECT_EQ(chunk[0], 'a');
+
+  serializer.reset(second);
+  EXPECT_FALSE(serializer.is_done());
+  serializer.write(chunk, sizeof(chunk));
+  EXPECT_EQ(chunk[0], 'c');
+  EXPECT_EQ(chunk[3], 3);
+}
+
+TEST(StreamingTest, FragmentsDeserializeToTheClass) {
+  // char@0 short@2 int@4 char@8; the serialized padding holds garbage
+  std::vector<unsigned char> frame{'a',  0xEE, 0x01, 0x02, 0x03, 0x04,
+                                   0x05, 0x06, 'b',  0xEE, 0xEE, 0xEE};
+  expect_fragments_match_deserialize<CharShortIntCharStruct,
+                                     Lp64BigEndianDataModel,
+                                     Lp64LittleEndianDataModel>(frame);
+  // a 4-byte long widened to 8
+  frame = {'c', 0xEE, 0xEE, 0xEE, 0xFF, 0xFF, 0xFF, 0xFE, 0x80, 0x00, 0x00,
+           0x01};
+  expect_fragments_match_deserialize<CharIntLongStruct,
+                                     Ilp32BigEndianDataModel,
+                                     Lp64LittleEndianDataModel>(frame);
+  // identical layouts are a single copy run
+  frame.resize(16, 0x11);
+  expect_fragments_match_deserialize<CharIntLongStruct,
+                                     Lp64LittleEndianDataModel,
+                                     Lp64LittleEndianDataModel>(frame);
+}
+
+TEST(StreamingTest, DeserializerStopsAtTheEndOfTheClass) {
+  const std::vector<unsigned char> frames{
+      'a', 0, 0x00, 0x01, 0, 0, 0, 0x02, 'b', 0, 0, 0,
+      'c', 0, 0x00, 0x03, 0, 0, 0, 0x04, 'd', 0, 0, 0};
+  CharShortIntCharStruct object{};
+  little_pp::serialization::ChunkedDeserializer<
+      CharShortIntCharStruct, Lp64BigEndianDataModel, Lp64LittleEndianDataModel>
+      deserializer(object);
+  ASSERT_EQ(deserializer.read(frames.data(), 5), 5U);
+  ASSERT_EQ(deserializer.read(frames.data() + 5, frames.size() - 5), 7U);
+  EXPECT_TRUE(deserializer.is_done());
+  EXPECT_EQ(object.baz, 2);
+  EXPECT_EQ(deserializer.read(frames.data() + 12, 12), 0U);
+
+  deserializer.reset();
+  ASSERT_EQ(deserializer.read(frames.data() + 12, 12), 12U);
+  EXPECT_EQ(object.bar, 'c');
+  EXPECT_EQ(object.foo, 3);
+  EXPECT_EQ(object.baz, 4);
+  EXPECT_EQ(object.buzz, 'd');
+}
+
+TEST(StreamingTest, PushStartsTheNextFrameAfterACompletedOne) {
+  const std::vector<unsigned char> frames{
+      'a', 0, 0x00, 0x01, 0, 0, 0, 0x02, 'b', 0, 0, 0,
+      'c', 0, 0x00, 0x03, 0, 0, 0, 0x04, 'd', 0, 0, 0};
+  CharShortIntCharStruct object{};
+  little_pp::serialization::ChunkedDeserializer<
+      CharShortIntCharStruct, Lp64BigEndianDataModel, Lp64LittleEndianDataModel>
+      deserializer(object);
+  std::size_t completed = 0;
+  for (std::size_t i = 0; i < frames.size(); ++i) {
+    // without reset(): no byte is dropped, and only frame ends report true
+    if (deserializer.push(frames[i])) {
+      EXPECT_EQ(i % 12, 11U);
+      completed++;
+      EXPECT_EQ(object.bar, completed == 1 ? 'a' : 'c');
+    }
+  }
+  EXPECT_EQ(completed, 2U);
+  EXPECT_EQ(object.baz, 4);
+  EXPECT_EQ(object.buzz, 'd');
+}
+
+}  // namespace
@@ -0,0 +1,61 @@
+#ifndef EXPECTED_DATA_CHAR_INT_CHAR_SHORT_DOUBLE_CHAR_STRUCT_H
+#define EXPECTED_DATA_CHAR_INT_CHAR_SHORT_DOUBLE_CHAR_STRUCT_H
+
+#include "interface_expected_data.h"
+#include "tested_data_models.h"
+
+namespace test_data {
+namespace struct_char_int_char_short_double_char {
+
+// NOLINTBEGIN (google-runtime-int)
+struct CharIntCharShortDoubleCharStruct {
+  char a;
+  int b;
+  char c;
+  short d;
+  double e;
+  char f;
+};
+// NOLINTEND (google-runtime-int)
+
+template <typename DataModelT>
+class ExpectedData : public IExpectedData<ExpectedData<DataModelT>> {};
+
+template <>
+class ExpectedData<test_data::data_models::Simple32BitDataModel>
+    : public IExpectedData<
+          ExpectedData<test_data::data_models::Simple32BitDataModel>> {
+ public:
+  using DataModelTypeImpl = test_data::data_models::Simple32BitDataModel;
+  using SerializedTypeImpl = CharIntCharShortDoubleCharStruct;
+
+  static constexpr std::size_t kExpectedPaddingLocationsCountImpl = 4;
+  static constexpr std::array<std::size_t, 4>
+      kExpectedPaddingLocationsByteCountsImpl{3, 1, 4, 7};
+  static constexpr std::array<std::size_t, 15> kExpectedPaddingByteIndexesImpl{
+      1, 2, 3, 9, 12, 13, 14, 15, 25, 26, 27, 28, 29, 30, 31};
+};
+
+// The int is only 2-aligned, so it and the short sit earlier, but the double
+// still starts at 16: the padding moves in front of the double.
+template <>
+class ExpectedData<
+    test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>
+    : public IExpectedData<ExpectedData<
+          test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>> {
+ public:
+  using DataModelTypeImpl =
+      test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel;
+  using SerializedTypeImpl = CharIntCharShortDoubleCharStruct;
+
+  static constexpr std::size_t kExpectedPaddingLocationsCountImpl = 4;
+  static constexpr std::array<std::size_t, 4>
+      kExpectedPaddingLocationsByteCountsImpl{1, 1, 6, 7};
+  static constexpr std::array<std::size_t, 15> kExpectedPaddingByteIndexesImpl{
+      1, 7, 10, 11, 12, 13, 14, 15, 25, 26, 27, 28, 29, 30, 31};
+};
+
+}  // namespace struct_char_int_char_short_double_char
+}  // namespace test_data
+
+#endif  //  EXPECTED_DATA_CHAR_INT_CHAR_SHORT_DOUBLE_CHAR_STRUCT_H
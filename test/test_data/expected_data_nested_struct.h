@@ -0,0 +1,60 @@
+#ifndef EXPECTED_DATA_NESTED_STRUCT_H
+#define EXPECTED_DATA_NESTED_STRUCT_H
+
+#include "interface_expected_data.h"
+#include "tested_data_models.h"
+
+namespace test_data {
+namespace struct_nested {
+
+struct IntChar {
+  int x;
+  char y;
+};
+
+// The inner struct's trailing padding is padding of the outer struct too.
+struct CharIntCharCharStruct {
+  char a;
+  IntChar inner;
+  char b;
+};
+
+template <typename DataModelT>
+class ExpectedData : public IExpectedData<ExpectedData<DataModelT>> {};
+
+template <>
+class ExpectedData<test_data::data_models::Simple32BitDataModel>
+    : public IExpectedData<
+          ExpectedData<test_data::data_models::Simple32BitDataModel>> {
+ public:
+  using DataModelTypeImpl = test_data::data_models::Simple32BitDataModel;
+  using SerializedTypeImpl = CharIntCharCharStruct;
+
+  static constexpr std::size_t kExpectedPaddingLocationsCountImpl = 3;
+  static constexpr std::array<std::size_t, 3>
+      kExpectedPaddingLocationsByteCountsImpl{3, 3, 3};
+  static constexpr std::array<std::size_t, 9> kExpectedPaddingByteIndexesImpl{
+      1, 2, 3, 9, 10, 11, 13, 14, 15};
+};
+
+template <>
+class ExpectedData<
+    test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>
+    : public IExpectedData<ExpectedData<
+          test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>> {
+ public:
+  using DataModelTypeImpl =
+      test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel;
+  using SerializedTypeImpl = CharIntCharCharStruct;
+
+  static constexpr std::size_t kExpectedPaddingLocationsCountImpl = 3;
+  static constexpr std::array<std::size_t, 3>
+      kExpectedPaddingLocationsByteCountsImpl{1, 1, 1};
+  static constexpr std::array<std::size_t, 3> kExpectedPaddingByteIndexesImpl{
+      1, 7, 9};
+};
+
+}  // namespace struct_nested
+}  // namespace test_data
+
+#endif  //  EXPECTED_DATA_NESTED_STRUCT_H
@@ -0,0 +1,64 @@
+#ifndef EXPECTED_DATA_STD_ARRAY_STRUCT_H
+#define EXPECTED_DATA_STD_ARRAY_STRUCT_H
+
+#include <array>
+
+#include "interface_expected_data.h"
+#include "tested_data_models.h"
+
+namespace test_data {
+namespace struct_std_array {
+
+// NOLINTBEGIN (google-runtime-int)
+struct IntChar {
+  int x;
+  char y;
+};
+
+// Array elements are strided by their size, trailing padding included.
+struct CharShortArrayStructArrayStruct {
+  char tag;
+  std::array<short, 3> samples;
+  std::array<IntChar, 2> items;
+};
+// NOLINTEND (google-runtime-int)
+
+template <typename DataModelT>
+class ExpectedData : public IExpectedData<ExpectedData<DataModelT>> {};
+
+template <>
+class ExpectedData<test_data::data_models::Simple32BitDataModel>
+    : public IExpectedData<
+          ExpectedData<test_data::data_models::Simple32BitDataModel>> {
+ public:
+  using DataModelTypeImpl = test_data::data_models::Simple32BitDataModel;
+  using SerializedTypeImpl = CharShortArrayStructArrayStruct;
+
+  static constexpr std::size_t kExpectedPaddingLocationsCountImpl = 3;
+  static constexpr std::array<std::size_t, 3>
+      kExpectedPaddingLocationsByteCountsImpl{1, 3, 3};
+  static constexpr std::array<std::size_t, 7> kExpectedPaddingByteIndexesImpl{
+      1, 13, 14, 15, 21, 22, 23};
+};
+
+template <>
+class ExpectedData<
+    test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>
+    : public IExpectedData<ExpectedData<
+          test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel>> {
+ public:
+  using DataModelTypeImpl =
+      test_data::data_models::Simple32BitButIntsNotSelfAlignedDataModel;
+  using SerializedTypeImpl = CharShortArrayStructArrayStruct;
+
+  static constexpr std::size_t kExpectedPaddingLocationsCountImpl = 3;
+  static constexpr std::array<std::size_t, 3>
+      kExpectedPaddingLocationsByteCountsImpl{1, 1, 1};
+  static constexpr std::array<std::size_t, 3> kExpectedPaddingByteIndexesImpl{
+      1, 13, 19};
+};
+
+}  // namespace struct_std_array
+}  // namespace test_data
+
+#endif  //  EXPECTED_DATA_STD_ARRAY_STRUCT_H
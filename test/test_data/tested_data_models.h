@@ -35,6 +35,91 @@ using Simple32BitButIntsNotSelfAlignedDataModel =
                          4, 4, 8, 8, 8, 8,
 
                          1, 1>;
+using Simple32BitBigEndianDataModel =
+    little_pp::DataModel<1, 1, 1, 1, 1, 1, 2, 2,
+
+                         2, 2, 2, 2,
+
+                         4, 4, 4, 4,
+
+                         8, 8, 8, 8,
+
+                         8, 8, 8, 8,
+
+                         4, 4, 8, 8, 8, 8,
+
+                         1, 1,
+
+                         little_pp::Endianess::kBigEndian>;
+
+// Mainstream 64-bit Unix (LP64), in both byte orders.
+using Lp64LittleEndianDataModel =
+    little_pp::DataModel<1, 1, 1, 1, 1, 1, 4, 4,
+
+                         2, 2, 2, 2,
+
+                         4, 4, 4, 4,
+
+                         8, 8, 8, 8,
+
+                         8, 8, 8, 8,
+
+                         4, 4, 8, 8, 16, 16,
+
+                         1, 1,
+
+                         little_pp::Endianess::kLittleEndian>;
+using Lp64BigEndianDataModel =
+    little_pp::DataModel<1, 1, 1, 1, 1, 1, 4, 4,
+
+                         2, 2, 2, 2,
+
+                         4, 4, 4, 4,
+
+                         8, 8, 8, 8,
+
+                         8, 8, 8, 8,
+
+                         4, 4, 8, 8, 16, 16,
+
+                         1, 1,
+
+                         little_pp::Endianess::kBigEndian>;
+
+// A 32-bit big-endian microcontroller (ILP32); longs shrink to 4 bytes.
+using Ilp32BigEndianDataModel =
+    little_pp::DataModel<1, 1, 1, 1, 1, 1, 4, 4,
+
+                         2, 2, 2, 2,
+
+                         4, 4, 4, 4,
+
+                         4, 4, 4, 4,
+
+                         8, 8, 8, 8,
+
+                         4, 4, 8, 8, 8, 8,
+
+                         1, 1,
+
+                         little_pp::Endianess::kBigEndian>;
+
+using Simple32BitButIntsNotSelfAlignedBigEndianDataModel =
+    little_pp::DataModel<1, 1, 1, 1, 1, 1, 2, 2,
+
+                         2, 2, 2, 2,
+
+                         4, 2, 4, 2,
+
+                         8, 8, 8, 8,
+
+                         8, 8, 8, 8,
+
+                         4, 4, 8, 8, 8, 8,
+
+                         1, 1,
+
+                         little_pp::Endianess::kBigEndian>;
 // NOLINTEND(*-magic-numbers)
 // clang-format on
 }  // namespace data_models
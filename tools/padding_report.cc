@@ -0,0 +1,63 @@
+// ABOUT: Prints a JSON padding report (see include/padding_report.h) of two
+//        example wire structs: one JSON array with an object per class. Run
+//        with `bazelisk run //tools:padding_report`.
+//
+//        To track a project's wire structs, copy this file next to them,
+//        replace the structs and data models below with the project's and
+//        depend on //include:little_pp_report; the values are computed at
+//        compile time, so the report only needs to be rebuilt.
+
+#include "include/padding_report.h"
+
+#include <cstdint>
+
+#include "include/data_model.h"
+
+namespace {
+
+// NOLINTBEGIN(*-magic-numbers)
+// clang-format off
+// A 32-bit big-endian microcontroller (ILP32) that aligns 8-byte types to 4
+// bytes.
+using Ilp32BigEndianDataModel =
+    little_pp::DataModel<1, 1, 1, 1, 1, 1, 4, 4,
+
+                         2, 2, 2, 2,
+
+                         4, 4, 4, 4,
+
+                         4, 4, 4, 4,
+
+                         8, 4, 8, 4,
+
+                         4, 4, 8, 4, 8, 4,
+
+                         1, 1,
+
+                         little_pp::Endianess::kBigEndian>;
+// clang-format on
+// NOLINTEND(*-magic-numbers)
+
+struct SensorFrame {
+  std::uint8_t status;
+  double timestamp;
+  std::uint16_t channel;
+  std::int32_t value;
+};
+
+struct CommandFrame {
+  std::uint8_t opcode;
+  std::uint32_t address;
+  std::uint16_t length;
+  bool needs_ack;
+};
+
+}  // namespace
+
+auto main() -> int {
+  using little_pp::padding_reflection::DataModels;
+  return little_pp::padding_reflection::padding_report_main<
+      DataModels<little_pp::NativeDataModel, Ilp32BigEndianDataModel>,
+      SensorFrame, CommandFrame>({{"SensorFrame", "CommandFrame"}},
+                                 {{"native", "ilp32_big_endian"}});
+}